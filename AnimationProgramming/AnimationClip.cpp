@@ -0,0 +1,320 @@
+#include "AnimationClip.h"
+
+#pragma region Standard
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#pragma endregion
+
+/// Find the keys surrounding a time in seconds, the first and the last keys are at the start and the end of the clip
+KeyPosition			findKeyPosition(float _time, float _duration, size_t _keyCount)
+{
+	KeyPosition position;
+
+	if (_keyCount < 2 || _duration <= 0.f)
+		return position;
+
+	float keyPosition = _time / _duration * float(_keyCount - 1);
+
+	if (keyPosition <= 0.f)
+		return position;
+
+	size_t key = static_cast<size_t>(keyPosition);
+
+	if (key >= _keyCount - 1)
+	{
+		position.m_key = _keyCount - 1;
+		position.m_nextKey = _keyCount - 1;
+
+		return position;
+	}
+
+	position.m_key = key;
+	position.m_nextKey = key + 1;
+	position.m_t = keyPosition - float(key);
+
+	return position;
+}
+
+/// Allocate the key arrays with identity transforms and one track per bone
+void				AnimationClip::resize(size_t _boneCount, size_t _keyCount)
+{
+	m_boneCount = _boneCount;
+	m_keyCount = _keyCount;
+
+	m_rotations.assign(_boneCount * _keyCount, LibMath::Quaternion(1.f, 0.f, 0.f, 0.f));
+	m_translations.assign(_boneCount * _keyCount, LibMath::Vector3(0.f, 0.f, 0.f));
+	m_scales.assign(_boneCount * _keyCount, LibMath::Vector3(1.f, 1.f, 1.f));
+
+	Transform identity;
+	identity.m_scale = LibMath::Vector3(1.f, 1.f, 1.f);
+
+	m_constantPose.assign(_boneCount, identity);
+	m_trackClasses.assign(_boneCount, TrackClass::Animated);
+	m_rotationTracks.resize(_boneCount);
+	m_translationTracks.resize(_boneCount);
+	m_rotationBones.resize(_boneCount);
+	m_translationBones.resize(_boneCount);
+
+	for (size_t i = 0; i < _boneCount; ++i)
+	{
+		m_rotationTracks[i] = static_cast<int>(i);
+		m_translationTracks[i] = static_cast<int>(i);
+		m_rotationBones[i] = static_cast<uint32_t>(i);
+		m_translationBones[i] = static_cast<uint32_t>(i);
+	}
+}
+
+/// Store the channels that never change once and keep a track for the others only
+void				AnimationClip::classifyTracks(TrackClassificationSettings const& _settings)
+{
+	if (m_keyCount == 0)
+		return;
+
+	std::vector<Transform> constantPose(m_boneCount);
+	std::vector<int> rotationTracks(m_boneCount, -1);
+	std::vector<int> translationTracks(m_boneCount, -1);
+	std::vector<uint32_t> rotationBones;
+	std::vector<uint32_t> translationBones;
+
+	for (size_t i = 0; i < m_boneCount; ++i)
+	{
+		Transform first = getKey(0, i);
+
+		bool isRotationConstant = true;
+		bool isTranslationConstant = true;
+
+		for (size_t j = 1; j < m_keyCount && (isRotationConstant || isTranslationConstant); ++j)
+		{
+			LibMath::Quaternion rotation = this->rotation(j, i);
+			LibMath::Vector3 translation = this->translation(j, i);
+			LibMath::Vector3 scale = this->scale(j, i);
+
+			isRotationConstant = isRotationConstant && 
+				std::fabs(rotation.m_a - first.m_rotation.m_a) <= _settings.m_rotationTolerance &&
+				std::fabs(rotation.m_b - first.m_rotation.m_b) <= _settings.m_rotationTolerance &&
+				std::fabs(rotation.m_c - first.m_rotation.m_c) <= _settings.m_rotationTolerance &&
+				std::fabs(rotation.m_d - first.m_rotation.m_d) <= _settings.m_rotationTolerance;
+
+			/*The scale shares the track of the translation, the clips never scale a bone on its own*/
+			isTranslationConstant = isTranslationConstant &&
+				std::fabs(translation.m_x - first.m_position.m_x) <= _settings.m_translationTolerance &&
+				std::fabs(translation.m_y - first.m_position.m_y) <= _settings.m_translationTolerance &&
+				std::fabs(translation.m_z - first.m_position.m_z) <= _settings.m_translationTolerance &&
+				std::fabs(scale.m_x - first.m_scale.m_x) <= _settings.m_translationTolerance &&
+				std::fabs(scale.m_y - first.m_scale.m_y) <= _settings.m_translationTolerance &&
+				std::fabs(scale.m_z - first.m_scale.m_z) <= _settings.m_translationTolerance;
+		}
+
+		constantPose[i] = first;
+
+		if (!isRotationConstant)
+		{
+			rotationTracks[i] = static_cast<int>(rotationBones.size());
+			rotationBones.push_back(static_cast<uint32_t>(i));
+		}
+
+		if (!isTranslationConstant)
+		{
+			translationTracks[i] = static_cast<int>(translationBones.size());
+			translationBones.push_back(static_cast<uint32_t>(i));
+		}
+
+		if (!isTranslationConstant)
+			m_trackClasses[i] = TrackClass::Animated;
+		else
+			m_trackClasses[i] = isRotationConstant ? TrackClass::Constant : TrackClass::RotationOnly;
+	}
+
+	/*Copy the animated tracks key-major, reading through the current layout*/
+	std::vector<LibMath::Quaternion> rotations(m_keyCount * rotationBones.size());
+	std::vector<LibMath::Vector3> translations(m_keyCount * translationBones.size());
+	std::vector<LibMath::Vector3> scales(m_keyCount * translationBones.size());
+
+	for (size_t j = 0; j < m_keyCount; ++j)
+	{
+		for (size_t track = 0; track < rotationBones.size(); ++track)
+		{
+			rotations[j * rotationBones.size() + track] = rotation(j, rotationBones[track]);
+		}
+
+		for (size_t track = 0; track < translationBones.size(); ++track)
+		{
+			translations[j * translationBones.size() + track] = translation(j, translationBones[track]);
+			scales[j * translationBones.size() + track] = scale(j, translationBones[track]);
+		}
+	}
+
+	m_rotations.swap(rotations);
+	m_translations.swap(translations);
+	m_scales.swap(scales);
+	m_constantPose.swap(constantPose);
+	m_rotationTracks.swap(rotationTracks);
+	m_translationTracks.swap(translationTracks);
+	m_rotationBones.swap(rotationBones);
+	m_translationBones.swap(translationBones);
+}
+
+/// Index of a bone at a key in a pose array of every key, such as a baked world pose
+size_t				AnimationClip::keyIndex(size_t _key, size_t _bone) const
+{
+	return _key * m_boneCount + _bone;
+}
+
+/// Set the transform of a bone at a key, only before classifyTracks
+void				AnimationClip::setKey(size_t _key, size_t _bone, Transform const& _transform)
+{
+	/*Every bone still has its own tracks so the index of the bone is the index of its tracks*/
+	assert(m_rotationBones.size() == m_boneCount && m_translationBones.size() == m_boneCount);
+
+	size_t index = keyIndex(_key, _bone);
+
+	m_rotations[index]		= _transform.m_rotation;
+	m_translations[index]	= _transform.m_position;
+	m_scales[index]			= _transform.m_scale;
+}
+
+/// Get the transform of a bone at a key
+Transform			AnimationClip::getKey(size_t _key, size_t _bone) const
+{
+	Transform result;
+	result.m_position	= translation(_key, _bone);
+	result.m_rotation	= rotation(_key, _bone);
+	result.m_scale		= scale(_key, _bone);
+
+	return result;
+}
+
+/// Get the rotation of a bone at a key
+LibMath::Quaternion	AnimationClip::rotation(size_t _key, size_t _bone) const
+{
+	int track = m_rotationTracks[_bone];
+
+	return track == -1 ? m_constantPose[_bone].m_rotation : m_rotations[_key * m_rotationBones.size() + track];
+}
+
+/// Get the translation of a bone at a key
+LibMath::Vector3	AnimationClip::translation(size_t _key, size_t _bone) const
+{
+	int track = m_translationTracks[_bone];
+
+	return track == -1 ? m_constantPose[_bone].m_position : m_translations[_key * m_translationBones.size() + track];
+}
+
+/// Get the scale of a bone at a key
+LibMath::Vector3	AnimationClip::scale(size_t _key, size_t _bone) const
+{
+	int track = m_translationTracks[_bone];
+
+	return track == -1 ? m_constantPose[_bone].m_scale : m_scales[_key * m_translationBones.size() + track];
+}
+
+/// Number of bones of a class
+size_t				AnimationClip::trackClassCount(TrackClass _trackClass) const
+{
+	return static_cast<size_t>(std::count(m_trackClasses.begin(), m_trackClasses.end(), _trackClass));
+}
+
+/// Copy every bone of a key into a pose
+void				AnimationClip::sampleKey(size_t _key, Transform* _pose) const
+{
+	size_t rotationTrackCount = m_rotationBones.size();
+	size_t translationTrackCount = m_translationBones.size();
+
+	const LibMath::Quaternion*	rotations		= m_rotations.data() + _key * rotationTrackCount;
+	const LibMath::Vector3*		translations	= m_translations.data() + _key * translationTrackCount;
+	const LibMath::Vector3*		scales			= m_scales.data() + _key * translationTrackCount;
+
+	/*The constant channels are copied as they are, the tracks overwrite the others*/
+	std::copy(m_constantPose.begin(), m_constantPose.end(), _pose);
+
+	for (size_t track = 0; track < translationTrackCount; ++track)
+	{
+		Transform& transform = _pose[m_translationBones[track]];
+
+		transform.m_position	= translations[track];
+		transform.m_scale		= scales[track];
+	}
+
+	for (size_t track = 0; track < rotationTrackCount; ++track)
+	{
+		_pose[m_rotationBones[track]].m_rotation = rotations[track];
+	}
+}
+
+/// Interpolate every bone between two keys into a pose
+void				AnimationClip::samplePose(size_t _key, size_t _nextKey, float _t, Transform* _pose) const
+{
+	size_t rotationTrackCount = m_rotationBones.size();
+	size_t translationTrackCount = m_translationBones.size();
+
+	const LibMath::Quaternion*	rotations			= m_rotations.data() + _key * rotationTrackCount;
+	const LibMath::Vector3*		translations		= m_translations.data() + _key * translationTrackCount;
+	const LibMath::Vector3*		scales				= m_scales.data() + _key * translationTrackCount;
+
+	const LibMath::Quaternion*	nextRotations		= m_rotations.data() + _nextKey * rotationTrackCount;
+	const LibMath::Vector3*		nextTranslations	= m_translations.data() + _nextKey * translationTrackCount;
+	const LibMath::Vector3*		nextScales			= m_scales.data() + _nextKey * translationTrackCount;
+
+	/*Constant channels skip the interpolation*/
+	std::copy(m_constantPose.begin(), m_constantPose.end(), _pose);
+
+	for (size_t track = 0; track < translationTrackCount; ++track)
+	{
+		Transform& transform = _pose[m_translationBones[track]];
+
+		transform.m_position	= LibMath::Vector3::lerpPosition(translations[track], nextTranslations[track], _t);
+		transform.m_scale		= LibMath::Vector3::lerpScale(scales[track], nextScales[track], _t);
+	}
+
+	/*One loop per interpolation so the choice is not made for every bone*/
+	switch (m_rotationInterpolation)
+	{
+	case LibMath::RotationInterpolation::Nlerp:
+		for (size_t track = 0; track < rotationTrackCount; ++track)
+		{
+			_pose[m_rotationBones[track]].m_rotation = LibMath::nlerp(rotations[track], nextRotations[track], _t);
+		}
+		break;
+	case LibMath::RotationInterpolation::ApproximateSlerp:
+		for (size_t track = 0; track < rotationTrackCount; ++track)
+		{
+			_pose[m_rotationBones[track]].m_rotation = LibMath::approximateSlerp(rotations[track], nextRotations[track], _t);
+		}
+		break;
+	default:
+		for (size_t track = 0; track < rotationTrackCount; ++track)
+		{
+			_pose[m_rotationBones[track]].m_rotation = LibMath::slerp(rotations[track], nextRotations[track], _t);
+		}
+		break;
+	}
+}
+
+/// Interpolate every bone at a time in seconds, clamped to the clip
+void				AnimationClip::sampleTime(float _time, Transform* _pose) const
+{
+	KeyPosition position = findKeyPosition(_time, m_duration, m_keyCount);
+
+	if (position.m_key == position.m_nextKey)
+	{
+		sampleKey(position.m_key, _pose);
+	}
+	else
+	{
+		samplePose(position.m_key, position.m_nextKey, position.m_t, _pose);
+	}
+}
+
+/// Memory used by the key arrays, the constant pose and the track tables in bytes
+size_t				AnimationClip::footprint() const
+{
+	return m_rotations.size() * sizeof(LibMath::Quaternion) +
+		   m_translations.size() * sizeof(LibMath::Vector3) +
+		   m_scales.size() * sizeof(LibMath::Vector3) +
+		   m_constantPose.size() * sizeof(Transform) + m_trackClasses.size() * sizeof(TrackClass) +
+		   (m_rotationTracks.size() + m_translationTracks.size()) * sizeof(int) +
+		   (m_rotationBones.size() + m_translationBones.size()) * sizeof(uint32_t);
+}
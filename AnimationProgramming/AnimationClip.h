@@ -0,0 +1,113 @@
+#pragma once
+
+#pragma region Animation
+
+#include "Transform.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstdint>
+#include <vector>
+
+#pragma endregion
+
+/// Keys surrounding a time of a clip and the interpolation factor between them
+struct KeyPosition
+{
+	size_t					m_key = 0;
+	size_t					m_nextKey = 0;
+	float					m_t = 0.f;
+};
+
+/// Find the keys surrounding a time in seconds, the first and the last keys are at the start and the end of the clip
+KeyPosition				findKeyPosition(float _time, float _duration, size_t _keyCount);
+
+/// Tracks of a bone sorted by what changes between the keys of a clip
+enum class TrackClass : uint8_t
+{
+	Constant, // Same transform at every key, stored once
+	RotationOnly, // Only the rotation changes, the translation and the scale are stored once
+	Animated // The translation or the scale changes
+};
+
+/// Tolerances under which a track is considered constant by classifyTracks
+struct TrackClassificationSettings
+{
+	float					m_rotationTolerance = 1e-5f; // Largest difference of a quaternion component to the first key
+	float					m_translationTolerance = 1e-4f; // Largest difference of a translation or scale component
+};
+
+/// Foot of a foot plant marker
+enum class Foot : uint8_t
+{
+	Left,
+	Right
+};
+
+/// Key where a foot is planted, placed on the clips by detectFootPlants
+struct SyncMarker
+{
+	float					m_phase = 0.f; // Position in the cycle, 0 at the first key and 1 at the last one
+	Foot					m_foot = Foot::Left;
+};
+
+/// Animation keys stored key-major: all the tracks of a key are adjacent so sampling a frame is a linear read.
+/// Every bone has its own track until classifyTracks stores the constant channels once in the constant pose
+struct AnimationClip
+{
+	std::vector<LibMath::Quaternion>	m_rotations; // Rotation of every rotation track for every key
+	std::vector<LibMath::Vector3>		m_translations; // Translation of every translation track for every key
+	std::vector<LibMath::Vector3>		m_scales; // Scale of every translation track for every key
+
+	std::vector<Transform>				m_constantPose; // Channels stored once, the sampler starts from this pose
+	std::vector<TrackClass>				m_trackClasses; // Class of the tracks of every bone
+	std::vector<int>					m_rotationTracks; // Rotation track of every bone, -1 if stored once
+	std::vector<int>					m_translationTracks; // Translation and scale track of every bone, -1 if stored once
+	std::vector<uint32_t>				m_rotationBones; // Bone of every rotation track
+	std::vector<uint32_t>				m_translationBones; // Bone of every translation and scale track
+
+	size_t								m_boneCount = 0; // Number of bones per key
+	size_t								m_keyCount = 0; // Number of keys
+
+	float								m_duration = 0.f; // Duration in seconds
+
+	std::vector<SyncMarker>				m_syncMarkers; // Foot plants sorted by phase, empty if they were not detected
+
+	LibMath::RotationInterpolation		m_rotationInterpolation = LibMath::RotationInterpolation::Slerp; // Used between keys and by the two pose blends of the clip, blends of more poses always use nlerp
+
+	/// Initialize
+	// Allocate the key arrays with identity transforms and one track per bone
+	void					resize(size_t _boneCount, size_t _keyCount);
+	// Store the channels that never change once and keep a track for the others only
+	void					classifyTracks(TrackClassificationSettings const& _settings = TrackClassificationSettings());
+
+	/// Access
+	// Index of a bone at a key in a pose array of every key, such as a baked world pose
+	size_t					keyIndex(size_t _key, size_t _bone) const;
+	// Set the transform of a bone at a key, only before classifyTracks
+	void					setKey(size_t _key, size_t _bone, Transform const& _transform);
+	// Get the transform of a bone at a key
+	Transform				getKey(size_t _key, size_t _bone) const;
+	// Get the rotation of a bone at a key
+	LibMath::Quaternion		rotation(size_t _key, size_t _bone) const;
+	// Get the translation of a bone at a key
+	LibMath::Vector3		translation(size_t _key, size_t _bone) const;
+	// Get the scale of a bone at a key
+	LibMath::Vector3		scale(size_t _key, size_t _bone) const;
+	// Number of bones of a class
+	size_t					trackClassCount(TrackClass _trackClass) const;
+
+	/// Sample
+	// Copy every bone of a key into a pose
+	void					sampleKey(size_t _key, Transform* _pose) const;
+	// Interpolate every bone between two keys into a pose
+	void					samplePose(size_t _key, size_t _nextKey, float _t, Transform* _pose) const;
+	// Interpolate every bone at a time in seconds, clamped to the clip
+	void					sampleTime(float _time, Transform* _pose) const;
+
+	/// Memory
+	// Memory used by the key arrays, the constant pose and the track tables in bytes
+	size_t					footprint() const;
+};
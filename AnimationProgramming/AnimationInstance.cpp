@@ -0,0 +1,106 @@
+#include "AnimationInstance.h"
+
+#pragma region Standard
+
+#include <cmath>
+
+#pragma endregion
+
+/// Bind the instance to a skeleton and a clip and allocate its poses
+void				AnimationInstance::initialize(Skeleton const& _skeleton, AnimationClip const& _clip, float _time,
+												  PaletteFormat _paletteFormat)
+{
+	m_skeleton = &_skeleton;
+	m_clip = &_clip;
+	m_time = 0.f;
+	m_evaluatedTime = -1.f;
+	m_paletteTime = -1.f;
+	m_paletteFormat = _paletteFormat;
+
+	m_localPose.resize(_skeleton.m_boneCount);
+	m_worldPose.resize(_skeleton.m_boneCount);
+
+	/*Only the palette of the selected format is kept, padded so it can be sent as it is*/
+	size_t capacity = paletteCapacity(m_paletteFormat, _skeleton.m_boneCount);
+
+	m_palette.resize(m_paletteFormat == PaletteFormat::Matrix4 ? capacity : 0);
+	m_affinePalette.resize(m_paletteFormat == PaletteFormat::Affine ? capacity : 0);
+	m_dualQuaternionPalette.resize(m_paletteFormat == PaletteFormat::DualQuaternion ? capacity : 0);
+
+	advance(_time);
+}
+
+/// Advance the time, looping at the end of the clip
+void				AnimationInstance::advance(float _frameTime)
+{
+	m_time += _frameTime * m_speed;
+
+	if (m_clip->m_duration > 0.f && (m_time >= m_clip->m_duration || m_time < 0.f))
+	{
+		m_time = std::fmod(m_time, m_clip->m_duration);
+
+		if (m_time < 0.f)
+			m_time += m_clip->m_duration;
+	}
+}
+
+/// Sample the clip or its baked world poses at the current time and build the palette, skipped if the time did not change
+void				AnimationInstance::evaluate()
+{
+	evaluatePose();
+	buildPalette();
+}
+
+/// Sample the clip or its baked world poses at the current time, skipped if the time did not change
+void				AnimationInstance::evaluatePose()
+{
+	/*A paused or idle character keeps the pose and the palette of the last evaluate*/
+	if (m_time == m_evaluatedTime)
+		return;
+
+	m_evaluatedTime = m_time;
+
+	/*A baked clip only interpolates two world poses*/
+	if (m_poseCache == nullptr || !m_poseCache->sampleTime(*m_clip, m_time, m_worldPose.data()))
+	{
+		m_clip->sampleTime(m_time, m_localPose.data());
+
+		m_skeleton->computeWorldPose(m_localPose.data(), m_worldPose.data());
+	}
+}
+
+/// Build the palette of the selected format from the world pose, skipped if it did not change
+void				AnimationInstance::buildPalette()
+{
+	if (m_paletteTime == m_evaluatedTime)
+		return;
+
+	m_paletteTime = m_evaluatedTime;
+
+	switch (m_paletteFormat)
+	{
+	case PaletteFormat::Affine:
+		m_skeleton->computeSkinningPalette(m_worldPose.data(), m_affinePalette.data());
+		break;
+	case PaletteFormat::DualQuaternion:
+		m_skeleton->computeSkinningPalette(m_worldPose.data(), m_dualQuaternionPalette.data());
+		break;
+	default:
+		m_skeleton->computeSkinningPalette(m_worldPose.data(), m_palette.data());
+		break;
+	}
+}
+
+/// Get the palette of the selected format as sent to SetSkinningPose
+const float*		AnimationInstance::paletteData() const
+{
+	switch (m_paletteFormat)
+	{
+	case PaletteFormat::Affine:
+		return &m_affinePalette[0].m_matrix[0][0];
+	case PaletteFormat::DualQuaternion:
+		return m_dualQuaternionPalette[0].m_real;
+	default:
+		return &m_palette[0].m_matrix[0][0];
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#pragma region Animation
+
+#include "Transform.h"
+#include "AnimationClip.h"
+#include "Skeleton.h"
+#include "WorldPoseCache.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <vector>
+
+#pragma endregion
+
+#pragma region LibMath
+
+#include "LibMath/Header/Matrix/Matrix4.h"
+
+#pragma endregion
+
+/// Playback state of one character, the clip and the skeleton are shared between characters
+struct AnimationInstance
+{
+	const AnimationClip*			m_clip = nullptr; // Clip played, not owned
+	const Skeleton*					m_skeleton = nullptr; // Skeleton animated, not owned
+	const WorldPoseCache*			m_poseCache = nullptr; // Baked world poses used instead of the sampling and the hierarchy, not owned
+
+	float							m_time = 0.f; // Time in the clip in seconds
+	float							m_speed = 1.f; // Playback speed
+	float							m_evaluatedTime = -1.f; // Time of the pose built by the last evaluate, -1 before the first one
+	float							m_paletteTime = -1.f; // Time of the pose the palette was built from, -1 before the first one
+
+	std::vector<Transform>			m_localPose; // Sampled local transform of every bone
+	std::vector<Transform>			m_worldPose; // World transform of every bone
+	std::vector<LibMath::Matrix4>	m_palette; // Skinning matrix of every bone, only with the Matrix4 format
+	std::vector<AffineMatrix>		m_affinePalette; // Affine skinning matrix of every bone, only with the affine format
+	std::vector<DualQuaternion>		m_dualQuaternionPalette; // Skinning dual quaternion of every bone, only with that format
+
+	PaletteFormat					m_paletteFormat = PaletteFormat::Matrix4; // Palette built by evaluate
+
+	/// Initialize
+	// Bind the instance to a skeleton and a clip and allocate its poses
+	void					initialize(Skeleton const& _skeleton, AnimationClip const& _clip, float _time = 0.f,
+									   PaletteFormat _paletteFormat = PaletteFormat::Matrix4);
+
+	/// Update
+	// Advance the time, looping at the end of the clip
+	void					advance(float _frameTime);
+	// Sample the clip or its baked world poses at the current time and build the palette, skipped if the time did not change
+	void					evaluate();
+	// Sample the clip or its baked world poses at the current time, skipped if the time did not change
+	void					evaluatePose();
+	// Build the palette of the selected format from the world pose, skipped if it did not change
+	void					buildPalette();
+
+	/// Getter
+	// Get the palette of the selected format as sent to SetSkinningPose
+	const float*			paletteData() const;
+};
@@ -2,12 +2,82 @@
 //
 
 #include "MySimulation.h"
+#include "Benchmark/Benchmark.h"
+#include "Headless/FrameReplay.h"
+#include "Headless/SkinningCheck.h"
+#include "Headless/AllocationCheck.h"
 
-int main()
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, char** argv)
 {
+	/*Run the math benchmarks instead of the simulation : --benchmark [name]*/
+	if (argc > 1 && strcmp(argv[1], "--benchmark") == 0)
+	{
+		return runBenchmarks(argc > 2 ? argv[2] : nullptr) ? 0 : 1;
+	}
+
+#ifdef HEADLESS_ENGINE
+	/*Replay every step on the headless engine : --replay [frame count] [frame time] [resource directory]*/
+	if (argc > 1 && strcmp(argv[1], "--replay") == 0)
+	{
+		size_t frameCount = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1000;
+		float frameTime = argc > 3 ? strtof(argv[3], nullptr) : 1.f / 60.f;
+		const char* resourceDirectory = argc > 4 ? argv[4] : "Data/Resources/";
+
+		return runFrameReplay(resourceDirectory, frameCount, frameTime) ? 0 : 1;
+	}
+
+	/*Compare the palette formats on the CPU : --check-skinning [frame count] [resource directory]*/
+	if (argc > 1 && strcmp(argv[1], "--check-skinning") == 0)
+	{
+		size_t frameCount = argc > 2 ? strtoul(argv[2], nullptr, 10) : 120;
+		const char* resourceDirectory = argc > 3 ? argv[3] : "Data/Resources/";
+
+		return runSkinningCheck(resourceDirectory, frameCount, 1.f / 60.f) ? 0 : 1;
+	}
+
+	/*Fail if a steady state update allocates : --check-allocations [frame count] [warm up frame count] [resource directory]*/
+	if (argc > 1 && strcmp(argv[1], "--check-allocations") == 0)
+	{
+		size_t frameCount = argc > 2 ? strtoul(argv[2], nullptr, 10) : 600;
+		size_t warmUpFrameCount = argc > 3 ? strtoul(argv[3], nullptr, 10) : 60;
+		const char* resourceDirectory = argc > 4 ? argv[4] : "Data/Resources/";
+
+		return runAllocationCheck(resourceDirectory, frameCount, warmUpFrameCount, 1.f / 60.f) ? 0 : 1;
+	}
+#endif
+
 	MySimulation simulation;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		/*Select the step to display : --step [1-7]*/
+		if (strcmp(argv[i], "--step") == 0)
+		{
+			simulation.selectStep(atoi(argv[i + 1]));
+		}
+		/*Select the palette sent to the shader : --palette [matrix4|affine|dq], see the matching skinning_*.program*/
+		else if (strcmp(argv[i], "--palette") == 0)
+		{
+			if (strcmp(argv[i + 1], "affine") == 0)
+			{
+				simulation.selectPaletteFormat(PaletteFormat::Affine);
+			}
+			else if (strcmp(argv[i + 1], "dq") == 0)
+			{
+				simulation.selectPaletteFormat(PaletteFormat::DualQuaternion);
+			}
+		}
+		/*Limit the memory of the baked world poses : --bake-budget [kilobytes], 0 samples and walks the hierarchy instead*/
+		else if (strcmp(argv[i], "--bake-budget") == 0)
+		{
+			simulation.setPoseCacheBudget(strtoul(argv[i + 1], nullptr, 10) * 1024);
+		}
+	}
+
 	Run(&simulation, 1400, 800);
 
 	return 0;
 }
-
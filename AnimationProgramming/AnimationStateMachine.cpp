@@ -0,0 +1,267 @@
+#include "AnimationStateMachine.h"
+
+#pragma region Animation
+
+#include "PoseBlend.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+#pragma endregion
+
+namespace
+{
+	/// Advance a time in the clip of a state, looping or holding the last key
+	float				advanceStateTime(AnimationState const& _state, float _time, float _frameTime)
+	{
+		float duration = _state.m_clip->m_duration;
+
+		_time += _frameTime * _state.m_speed;
+
+		if (duration <= 0.f)
+			return 0.f;
+
+		if (!_state.m_isLooping)
+			return std::min(std::max(_time, 0.f), duration);
+
+		_time = std::fmod(_time, duration);
+
+		return _time < 0.f ? _time + duration : _time;
+	}
+}
+
+/// Add a state playing a clip, return its index, the first state added is the entry state
+size_t				StateMachineDefinition::addState(const char* _name, AnimationClip const& _clip, float _speed,
+													 bool _isLooping)
+{
+	AnimationState state;
+	state.m_name = _name;
+	state.m_clip = &_clip;
+	state.m_speed = _speed;
+	state.m_isLooping = _isLooping;
+
+	m_states.push_back(state);
+
+	return m_states.size() - 1;
+}
+
+/// Add a float parameter set by the gameplay, return its index
+size_t				StateMachineDefinition::addParameter(const char* _name)
+{
+	m_parameterNames.push_back(_name);
+
+	return m_parameterNames.size() - 1;
+}
+
+/// Add a transition, the transitions of a state are tested in the order they were added
+void				StateMachineDefinition::addTransition(StateTransition const& _transition)
+{
+	assert(_transition.m_from < m_states.size() && _transition.m_to < m_states.size());
+
+	/*Inserted after the last transition of its source so the ranges stay contiguous*/
+	std::vector<StateTransition>::iterator position = std::upper_bound(m_transitions.begin(), m_transitions.end(),
+		_transition, [](StateTransition const& _lhs, StateTransition const& _rhs) { return _lhs.m_from < _rhs.m_from; });
+
+	m_transitions.insert(position, _transition);
+
+	for (AnimationState& state : m_states)
+	{
+		state.m_transitionCount = 0;
+	}
+
+	for (size_t i = m_transitions.size(); i-- > 0;)
+	{
+		AnimationState& state = m_states[m_transitions[i].m_from];
+
+		state.m_firstTransition = i;
+		++state.m_transitionCount;
+	}
+}
+
+/// Get the index of a state by name, -1 if it is not found
+int					StateMachineDefinition::findState(const char* _name) const
+{
+	for (size_t i = 0; i < m_states.size(); ++i)
+	{
+		if (m_states[i].m_name == _name)
+			return int(i);
+	}
+
+	return -1;
+}
+
+/// Get the index of a parameter by name, -1 if it is not found
+int					StateMachineDefinition::findParameter(const char* _name) const
+{
+	for (size_t i = 0; i < m_parameterNames.size(); ++i)
+	{
+		if (m_parameterNames[i] == _name)
+			return int(i);
+	}
+
+	return -1;
+}
+
+/// Bind the instance to a machine, enter its first state and reset the parameters to 0
+void				StateMachineInstance::initialize(StateMachineDefinition const& _definition, float _time)
+{
+	assert(_definition.stateCount() > 0);
+
+	m_definition = &_definition;
+	m_parameters.assign(_definition.parameterCount(), 0.f);
+
+	m_state = 0;
+	m_time = advanceStateTime(_definition.state(0), 0.f, _time);
+	m_stateElapsed = _time;
+
+	m_fadingState = -1;
+	m_fadingTime = 0.f;
+	m_fadeElapsed = 0.f;
+	m_fadeDuration = 0.f;
+
+	/*Every state of the machine animates the same skeleton*/
+	Transform identity;
+	identity.m_scale = LibMath::Vector3(1.f, 1.f, 1.f);
+
+	m_frozenPose.assign(_definition.state(0).m_clip->m_boneCount * 2, identity);
+	m_isFadingFrozenPose = false;
+}
+
+/// Advance the active states and take the first transition of the current state whose condition is met
+void				StateMachineInstance::update(float _frameTime)
+{
+	StateMachineDefinition const& definition = *m_definition;
+	AnimationState const& current = definition.state(m_state);
+
+	m_time = advanceStateTime(current, m_time, _frameTime);
+	m_stateElapsed += _frameTime;
+
+	if (m_fadingState != -1)
+	{
+		if (!m_isFadingFrozenPose)
+		{
+			m_fadingTime = advanceStateTime(definition.state(m_fadingState), m_fadingTime, _frameTime);
+		}
+
+		m_fadeElapsed += _frameTime;
+
+		if (m_fadeElapsed >= m_fadeDuration)
+		{
+			m_fadingState = -1;
+			m_isFadingFrozenPose = false;
+		}
+	}
+
+	/*Only the transitions leaving the current state are tested and one at most is taken*/
+	for (size_t i = 0; i < current.m_transitionCount; ++i)
+	{
+		StateTransition const& transition = definition.transition(current.m_firstTransition + i);
+		TransitionCondition const& condition = transition.m_condition;
+
+		bool isMet = false;
+
+		switch (condition.m_type)
+		{
+		case ConditionType::Greater:
+			isMet = m_parameters[condition.m_parameter] > condition.m_value;
+			break;
+		case ConditionType::Less:
+			isMet = m_parameters[condition.m_parameter] < condition.m_value;
+			break;
+		default:
+			isMet = m_stateElapsed * current.m_speed >= condition.m_value * current.m_clip->m_duration;
+			break;
+		}
+
+		if (!isMet)
+			continue;
+
+		/*Going back to the state being faded out reverses the cross-fade from the weight it reached, without a pop*/
+		if (m_fadingState == int(transition.m_to) && !m_isFadingFrozenPose && transition.m_fadeDuration > 0.f)
+		{
+			float reversedWeight = 1.f - weight();
+
+			m_fadingState = int(m_state);
+			std::swap(m_time, m_fadingTime);
+			m_fadeDuration = transition.m_fadeDuration;
+			m_fadeElapsed = reversedWeight * m_fadeDuration;
+
+			m_state = transition.m_to;
+			m_stateElapsed = 0.f;
+
+			break;
+		}
+
+		AnimationState const& target = definition.state(transition.m_to);
+		float phase = current.m_clip->m_duration > 0.f ? m_time / current.m_clip->m_duration : 0.f;
+
+		/*A transition to a third state during a cross-fade fades out from the blended pose of this frame, frozen, so
+		  nothing pops and two clips at most are still sampled*/
+		bool isFadingFrozenPose = m_fadingState != -1 && transition.m_fadeDuration > 0.f;
+
+		if (isFadingFrozenPose)
+		{
+			freezePose();
+		}
+
+		m_isFadingFrozenPose = isFadingFrozenPose;
+		m_fadingState = transition.m_fadeDuration > 0.f ? int(m_state) : -1;
+		m_fadingTime = m_time;
+		m_fadeElapsed = 0.f;
+		m_fadeDuration = transition.m_fadeDuration;
+
+		m_state = transition.m_to;
+		m_time = transition.m_isPhaseMatched ? phase * target.m_clip->m_duration : 0.f;
+		m_stateElapsed = 0.f;
+
+		break;
+	}
+}
+
+/// Sample the active states and blend them into _pose, _fadingPose receives the state faded out
+void				StateMachineInstance::evaluate(Transform* _pose, Transform* _fadingPose) const
+{
+	AnimationClip const& clip = *m_definition->state(m_state).m_clip;
+
+	clip.sampleTime(m_time, _pose);
+
+	if (m_fadingState == -1)
+		return;
+
+	const Transform* fadingPose = m_frozenPose.data();
+
+	if (!m_isFadingFrozenPose)
+	{
+		m_definition->state(m_fadingState).m_clip->sampleTime(m_fadingTime, _fadingPose);
+		fadingPose = _fadingPose;
+	}
+
+	blendPoses(fadingPose, _pose, weight(), clip.m_boneCount, _pose, clip.m_rotationInterpolation);
+}
+
+/// Blend the active states into the frozen pose, the source of the next cross-fade
+void				StateMachineInstance::freezePose()
+{
+	size_t boneCount = m_frozenPose.size() / 2;
+
+	/*The second half of the buffer receives the current state, the first one the source of the cross-fade*/
+	Transform* pose = m_frozenPose.data() + boneCount;
+
+	evaluate(pose, m_frozenPose.data());
+
+	std::copy(pose, pose + boneCount, m_frozenPose.data());
+}
+
+/// Weight of the current state, 1 outside of a cross-fade
+float				StateMachineInstance::weight() const
+{
+	if (m_fadingState == -1 || m_fadeDuration <= 0.f)
+		return 1.f;
+
+	return std::min(m_fadeElapsed / m_fadeDuration, 1.f);
+}
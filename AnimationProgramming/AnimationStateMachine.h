@@ -0,0 +1,124 @@
+#pragma once
+
+#pragma region Animation
+
+#include "Transform.h"
+#include "AnimationClip.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#pragma endregion
+
+/// Test of a transition, on a parameter of the character or on the time of the current state
+enum class ConditionType : uint8_t
+{
+	Greater, // The parameter is greater than the value
+	Less, // The parameter is less than the value
+	ExitTime // The current state played at least the value, as a fraction of its clip
+};
+
+/// Condition a transition waits for
+struct TransitionCondition
+{
+	ConditionType			m_type = ConditionType::ExitTime;
+	size_t					m_parameter = 0; // Index of the parameter tested, unused by ExitTime
+	float					m_value = 1.f; // Threshold of the parameter or fraction of the clip
+};
+
+/// Clip played by a state
+struct AnimationState
+{
+	std::string				m_name;
+	const AnimationClip*	m_clip = nullptr; // Clip played, not owned
+	float					m_speed = 1.f; // Playback speed
+	bool					m_isLooping = true; // Loop the clip, otherwise hold its last key
+
+	size_t					m_firstTransition = 0; // First transition leaving the state
+	size_t					m_transitionCount = 0; // Transitions leaving the state, stored after the first one
+};
+
+/// Cross-fade from a state to another once a condition is met
+struct StateTransition
+{
+	size_t					m_from = 0;
+	size_t					m_to = 0;
+	TransitionCondition		m_condition;
+	float					m_fadeDuration = 0.2f; // Seconds to cross-fade, 0 cuts
+	bool					m_isPhaseMatched = false; // Start the target at the phase of the source instead of 0
+};
+
+/// States, parameters and transitions shared read-only by every character playing the machine
+class StateMachineDefinition
+{
+	/// Variables
+	std::vector<AnimationState>		m_states;
+	std::vector<StateTransition>	m_transitions; // Sorted by source state so a state tests a contiguous range
+	std::vector<std::string>		m_parameterNames;
+
+public:
+
+	/// Initialize
+	// Add a state playing a clip, return its index, the first state added is the entry state
+	size_t					addState(const char* _name, AnimationClip const& _clip, float _speed = 1.f,
+									 bool _isLooping = true);
+	// Add a float parameter set by the gameplay, return its index
+	size_t					addParameter(const char* _name);
+	// Add a transition, the transitions of a state are tested in the order they were added
+	void					addTransition(StateTransition const& _transition);
+
+	/// Getter
+	size_t					stateCount() const { return m_states.size(); }
+	size_t					parameterCount() const { return m_parameterNames.size(); }
+	AnimationState const&	state(size_t _state) const { return m_states[_state]; }
+	StateTransition const&	transition(size_t _transition) const { return m_transitions[_transition]; }
+	// Get the index of a state or a parameter by name, -1 if it is not found
+	int						findState(const char* _name) const;
+	int						findParameter(const char* _name) const;
+};
+
+/// Playback of a state machine by one character : the current state and, during a cross-fade, the state it leaves or
+/// the pose frozen when a cross-fade was interrupted
+struct StateMachineInstance
+{
+	const StateMachineDefinition*	m_definition = nullptr; // Machine played, not owned
+
+	std::vector<float>		m_parameters; // Value of every parameter of the machine
+
+	size_t					m_state = 0; // Current state
+	float					m_time = 0.f; // Time in the clip of the current state in seconds
+	float					m_stateElapsed = 0.f; // Seconds since the current state was entered, tested by ExitTime
+
+	int						m_fadingState = -1; // State faded out, -1 without cross-fade
+	float					m_fadingTime = 0.f; // Time in the clip of the faded out state
+	float					m_fadeElapsed = 0.f; // Seconds since the cross-fade started
+	float					m_fadeDuration = 0.f; // Seconds the cross-fade lasts
+
+	std::vector<Transform>	m_frozenPose; // Blended pose left by a transition during a cross-fade, then room to sample
+										  // the current state while it is frozen, allocated by initialize
+	bool					m_isFadingFrozenPose = false; // The cross-fade starts from the frozen pose instead of a state
+
+	/// Initialize
+	// Bind the instance to a machine, enter its first state and reset the parameters to 0
+	void					initialize(StateMachineDefinition const& _definition, float _time = 0.f);
+
+	/// Update
+	// Set a parameter by index
+	void					setParameter(size_t _parameter, float _value) { m_parameters[_parameter] = _value; }
+	// Advance the active states and take the first transition of the current state whose condition is met
+	void					update(float _frameTime);
+	// Sample the active states and blend them into _pose, _fadingPose receives the state faded out
+	void					evaluate(Transform* _pose, Transform* _fadingPose) const;
+	// Blend the active states into the frozen pose, the source of the next cross-fade
+	void					freezePose();
+
+	/// Getter
+	bool					isFading() const { return m_fadingState != -1; }
+	// Weight of the current state, 1 outside of a cross-fade
+	float					weight() const;
+};
@@ -0,0 +1,227 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Transform.h"
+#include "../Skeleton.h"
+#include "../AnimationClip.h"
+#include "../ResourceFile.h"
+#include "../ThreadPool.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <cstring>
+#include <string>
+
+#pragma endregion
+
+volatile float g_benchmarkSink = 0.f;
+
+namespace
+{
+	/// Benchmark runnable by name from the command line
+	struct NamedBenchmark
+	{
+		const char*		m_name;
+		void			(*m_run)();
+	};
+
+	const NamedBenchmark g_benchmarks[] =
+	{
+		{ "inverse", runMatrixInverseBenchmark },
+		{ "kernels", runKernelBenchmark },
+		{ "crowd", runCrowdBenchmark },
+		{ "compression", runCompressionBenchmark },
+		{ "reduction", runReductionBenchmark },
+		{ "interpolation", runInterpolationBenchmark },
+		{ "skinning", runSkinningBenchmark },
+		{ "tracks", runTrackBenchmark },
+		{ "blend", runBlendBenchmark },
+		{ "statemachine", runStateMachineBenchmark },
+		{ "pipeline", runPipelineBenchmark },
+	};
+
+	/// Folders searched for the resources, from the Data folder then from the root of the repository
+	const char* const g_resourceDirectories[] = { "Resources/", "Data/Resources/" };
+}
+
+/// Call _run with thread pools of 1, 2, 4... threads up to _coreCount, the calling thread counted as one of them
+void					forEachThreadCount(unsigned int _coreCount, std::function<void(size_t, ThreadPool&)> const& _run)
+{
+	/*The calling thread works in wait so a pool with n workers runs on n + 1 threads*/
+	for (size_t threadCount = 1; threadCount <= (_coreCount > 1 ? _coreCount : 1); threadCount *= 2)
+	{
+		ThreadPool pool(threadCount - 1);
+
+		_run(threadCount, pool);
+	}
+}
+
+/// Create random bone like transforms with an uniform scale
+std::vector<Transform>	createRandomTransforms(size_t _count, float _scale, unsigned int _seed)
+{
+	std::mt19937 generator(_seed);
+	std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+	std::vector<Transform> transforms(_count);
+
+	for (Transform& transform : transforms)
+	{
+		transform.m_position = LibMath::Vector3(distribution(generator) * 100.f, distribution(generator) * 100.f, 
+												distribution(generator) * 100.f);
+		transform.m_rotation = LibMath::normalize(LibMath::Quaternion(distribution(generator), distribution(generator),
+																	  distribution(generator), distribution(generator)));
+		transform.m_scale = LibMath::Vector3(_scale, _scale, _scale);
+	}
+
+	return transforms;
+}
+
+/// Print one line of benchmark result
+void					printBenchmarkResult(const char* _name, BenchmarkResult const& _result)
+{
+	std::cout << std::left << std::setw(40) << _name << std::right << std::fixed
+			  << std::setw(12) << std::setprecision(2) << _result.m_nanosecondsPerOperation << " ns/op"
+			  << std::setw(14) << std::setprecision(2) << _result.m_operationsPerSecond / 1e6 << " Mop/s" << std::endl;
+}
+
+/// Print the speedup of a kernel against a reference
+void					printBenchmarkSpeedup(const char* _name, BenchmarkResult const& _reference, 
+											  BenchmarkResult const& _result)
+{
+	std::cout << std::left << std::setw(40) << _name << std::right << std::fixed
+			  << std::setw(12) << std::setprecision(2) 
+			  << _reference.m_nanosecondsPerOperation / _result.m_nanosecondsPerOperation << " x" << std::endl;
+}
+
+/// Load the skeleton without the IK bones and the walk and run clips from the resource folder, with classified tracks
+/// unless _classifyTracks is false
+bool					loadBenchmarkAssets(Skeleton& _skeleton, AnimationClip& _walkClip, AnimationClip& _runClip,
+											bool _classifyTracks)
+{
+	for (const char* directory : g_resourceDirectories)
+	{
+		SkeletonFile skeletonFile;
+		AnimationFile walkFile;
+		AnimationFile runFile;
+
+		std::string path(directory);
+
+		if (!skeletonFile.open((path + "ThirdPersonWalk.skel").c_str()) ||
+			!walkFile.open((path + "ThirdPersonWalk.anim").c_str()) ||
+			!runFile.open((path + "ThirdPersonRun.anim").c_str()))
+			continue;
+
+		std::vector<Transform> localBindPose;
+		std::vector<int> parentIndices;
+
+		/*The IK bones are not skinned, like in MySimulation*/
+		for (size_t i = 0; i < skeletonFile.boneCount(); ++i)
+		{
+			if (skeletonFile.hasPrefix(i, "ik_"))
+				continue;
+
+			Transform bind = skeletonFile.getBindTransform(i);
+			bind.m_scale = LibMath::Vector3(1.f, 1.f, 1.f);
+
+			localBindPose.push_back(bind);
+			parentIndices.push_back(skeletonFile.bone(i).m_parentIndex);
+		}
+
+		_skeleton.build(localBindPose, parentIndices);
+
+		walkFile.toClip(_walkClip, _skeleton.m_boneCount);
+		runFile.toClip(_runClip, _skeleton.m_boneCount);
+
+		/*Classified like MySimulation does once the clips are loaded*/
+		if (_classifyTracks)
+		{
+			_walkClip.classifyTracks();
+			_runClip.classifyTracks();
+		}
+
+		return true;
+	}
+
+	std::cout << "Cannot find the resources, run from the Data folder or the root of the repository" << std::endl;
+
+	return false;
+}
+
+/// Open SK_Mannequin.msh from the resource folder
+bool					openBenchmarkMesh(MeshFile& _mesh)
+{
+	for (const char* directory : g_resourceDirectories)
+	{
+		std::string path = std::string(directory) + "SK_Mannequin.msh";
+
+		if (_mesh.open(path.c_str()))
+			return true;
+	}
+
+	std::cout << "Cannot open SK_Mannequin.msh : " << _mesh.error() << std::endl;
+
+	return false;
+}
+
+/// Largest difference of any position, rotation or scale component between two poses of the same size
+float					largestDifference(std::vector<Transform> const& _lhs, std::vector<Transform> const& _rhs)
+{
+	float largest = 0.f;
+
+	for (size_t i = 0; i < _lhs.size(); ++i)
+	{
+		const float lhs[] = { _lhs[i].m_position.m_x, _lhs[i].m_position.m_y, _lhs[i].m_position.m_z,
+							  _lhs[i].m_rotation.m_a, _lhs[i].m_rotation.m_b, _lhs[i].m_rotation.m_c,
+							  _lhs[i].m_rotation.m_d, _lhs[i].m_scale.m_x, _lhs[i].m_scale.m_y, _lhs[i].m_scale.m_z };
+		const float rhs[] = { _rhs[i].m_position.m_x, _rhs[i].m_position.m_y, _rhs[i].m_position.m_z,
+							  _rhs[i].m_rotation.m_a, _rhs[i].m_rotation.m_b, _rhs[i].m_rotation.m_c,
+							  _rhs[i].m_rotation.m_d, _rhs[i].m_scale.m_x, _rhs[i].m_scale.m_y, _rhs[i].m_scale.m_z };
+
+		for (size_t component = 0; component < 10; ++component)
+		{
+			largest = std::fmax(largest, std::fabs(lhs[component] - rhs[component]));
+		}
+	}
+
+	return largest;
+}
+
+/// Run the benchmark with this name, or every benchmark if the name is null
+bool					runBenchmarks(const char* _name)
+{
+	bool hasRun = false;
+
+	for (NamedBenchmark const& benchmark : g_benchmarks)
+	{
+		if (_name == nullptr || strcmp(_name, benchmark.m_name) == 0)
+		{
+			benchmark.m_run();
+			hasRun = true;
+		}
+	}
+
+	if (!hasRun)
+	{
+		std::cout << "Unknown benchmark " << _name << ", available :";
+
+		for (NamedBenchmark const& benchmark : g_benchmarks)
+		{
+			std::cout << " " << benchmark.m_name;
+		}
+
+		std::cout << std::endl;
+	}
+
+	return hasRun;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#pragma region Standard
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#pragma endregion
+
+struct Transform;
+struct Skeleton;
+struct AnimationClip;
+class MeshFile;
+class ThreadPool;
+
+/// Result of a measured kernel
+struct BenchmarkResult
+{
+	double	m_nanosecondsPerOperation = 0.0; // Average cost of one operation
+	double	m_operationsPerSecond = 0.0; // Throughput
+};
+
+/// Sink written by every kernel so the compiler cannot remove the measured work
+extern volatile float g_benchmarkSink;
+
+/// Measure
+// Run the kernel _repeatCount times, each call doing _operationCount operations, and return the average cost
+template <typename Kernel>
+BenchmarkResult			measure(Kernel _kernel, size_t _repeatCount, size_t _operationCount = 1)
+{
+	/*Warm up the caches and the branch predictor*/
+	_kernel();
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < _repeatCount; ++i)
+	{
+		_kernel();
+	}
+
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+	double nanoseconds = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	double operationCount = double(_repeatCount) * double(_operationCount);
+
+	BenchmarkResult result;
+	result.m_nanosecondsPerOperation = nanoseconds / operationCount;
+	result.m_operationsPerSecond = operationCount * 1e9 / nanoseconds;
+
+	return result;
+}
+
+/// Print
+// Print one line of benchmark result
+void					printBenchmarkResult(const char* _name, BenchmarkResult const& _result);
+// Print the speedup of a kernel against a reference
+void					printBenchmarkSpeedup(const char* _name, BenchmarkResult const& _reference, 
+											  BenchmarkResult const& _result);
+
+/// Threads
+// Call _run with thread pools of 1, 2, 4... threads up to _coreCount, the calling thread counted as one of them
+void					forEachThreadCount(unsigned int _coreCount, std::function<void(size_t, ThreadPool&)> const& _run);
+
+/// Data
+// Create random bone like transforms with an uniform scale
+std::vector<Transform>	createRandomTransforms(size_t _count, float _scale, unsigned int _seed = 42);
+// Load the skeleton without the IK bones and the walk and run clips from the resource folder, with classified tracks
+// unless _classifyTracks is false
+bool					loadBenchmarkAssets(Skeleton& _skeleton, AnimationClip& _walkClip, AnimationClip& _runClip,
+											bool _classifyTracks = true);
+// Open SK_Mannequin.msh from the resource folder
+bool					openBenchmarkMesh(MeshFile& _mesh);
+
+/// Compare
+// Largest difference of any position, rotation or scale component between two poses of the same size
+float					largestDifference(std::vector<Transform> const& _lhs, std::vector<Transform> const& _rhs);
+
+/// Benchmarks
+// Compare the closed-form Matrix4 and Transform inverses with the generic adjugate inverse
+void					runMatrixInverseBenchmark();
+// Measure the animation hot kernels alone and in batches of 1, 64 and 4096 elements
+void					runKernelBenchmark();
+// Measure the crowd update on the calling thread, with the baked world poses and on thread pools of growing size
+void					runCrowdBenchmark();
+// Compress the walk and run clips, report the ratio and the error of every bone then time the decoding
+void					runCompressionBenchmark();
+// Reduce the walk and run clips with several tolerances and report the savings, the error and the sampling cost
+void					runReductionBenchmark();
+// Compare the cost and the accuracy of slerp, approximate slerp and nlerp, alone and when sampling the walk clip
+void					runInterpolationBenchmark();
+// Skin SK_Mannequin.msh on the CPU with every instruction set and thread count and report the vertices per second
+void					runSkinningBenchmark();
+// Classify the tracks of the walk and run clips and compare the sampling cost with one track per bone
+void					runTrackBenchmark();
+// Blend two and four sampled poses with every instruction set against one interpolate call per bone
+void					runBlendBenchmark();
+// Tick a walk and run state machine for thousands of characters, then sample their active states
+void					runStateMachineBenchmark();
+// Run the frame of a crowd serially, then as a task graph with the submission on the calling thread, on thread pools of growing size
+void					runPipelineBenchmark();
+// Run the benchmark with this name, or every benchmark if the name is null
+bool					runBenchmarks(const char* _name = nullptr);
@@ -0,0 +1,112 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Skeleton.h"
+#include "../AnimationClip.h"
+#include "../PoseBlend.h"
+
+#pragma endregion
+
+#pragma region LibMath
+
+#include "LibMath/Header/SIMD.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cmath>
+#include <vector>
+#include <string>
+#include <iostream>
+
+#pragma endregion
+
+/// Blend two and four sampled poses with every instruction set against one interpolate call per bone
+void					runBlendBenchmark()
+{
+	const size_t repeatCount = 4096;
+
+	Skeleton skeleton;
+	AnimationClip walkClip;
+	AnimationClip runClip;
+
+	if (!loadBenchmarkAssets(skeleton, walkClip, runClip))
+		return;
+
+	const size_t boneCount = skeleton.m_boneCount;
+
+	/*Two times in each clip so the four poses differ*/
+	std::vector<Transform> poses[4] = { std::vector<Transform>(boneCount), std::vector<Transform>(boneCount),
+										std::vector<Transform>(boneCount), std::vector<Transform>(boneCount) };
+	walkClip.sampleTime(walkClip.m_duration * 0.3f, poses[0].data());
+	runClip.sampleTime(runClip.m_duration * 0.3f, poses[1].data());
+	walkClip.sampleTime(walkClip.m_duration * 0.7f, poses[2].data());
+	runClip.sampleTime(runClip.m_duration * 0.7f, poses[3].data());
+
+	const Transform* posePointers[] = { poses[0].data(), poses[1].data(), poses[2].data(), poses[3].data() };
+	const float weights[] = { 0.4f, 0.3f, 0.2f, 0.1f };
+
+	std::vector<Transform> result(boneCount);
+	std::vector<Transform> reference(boneCount);
+	std::vector<Transform> fourWayReference(boneCount);
+
+	std::cout << "Pose blend (" << boneCount << " bones), one operation is a whole pose" << std::endl;
+
+	BenchmarkResult perBone = measure([&]()
+	{
+		for (size_t i = 0; i < boneCount; ++i)
+		{
+			result[i] = interpolate(poses[0][i], poses[1][i], 0.5f, LibMath::RotationInterpolation::Nlerp);
+		}
+		g_benchmarkSink = result[boneCount - 1].m_rotation.m_a;
+	}, repeatCount);
+
+	printBenchmarkResult("  interpolate per bone, 2 poses", perBone);
+
+	LibMath::InstructionSet activeSet = LibMath::activeInstructionSet();
+	LibMath::InstructionSet supportedSet = LibMath::detectInstructionSet();
+
+	/*The scalar kernel is the reference of the others*/
+	LibMath::selectInstructionSet(LibMath::InstructionSet::Scalar);
+	blendPoses(poses[0].data(), poses[1].data(), 0.5f, boneCount, reference.data());
+	blendPoses(posePointers, weights, 4, boneCount, fourWayReference.data());
+
+	for (int set = 0; set <= static_cast<int>(supportedSet); ++set)
+	{
+		LibMath::InstructionSet instructionSet = LibMath::selectInstructionSet(static_cast<LibMath::InstructionSet>(set));
+		std::string setName = LibMath::instructionSetName(instructionSet);
+
+		BenchmarkResult twoWay = measure([&]()
+		{
+			blendPoses(poses[0].data(), poses[1].data(), 0.5f, boneCount, result.data());
+			g_benchmarkSink = result[boneCount - 1].m_rotation.m_a;
+		}, repeatCount);
+
+		float twoWayDifference = largestDifference(result, reference);
+
+		BenchmarkResult fourWay = measure([&]()
+		{
+			blendPoses(posePointers, weights, 4, boneCount, result.data());
+			g_benchmarkSink = result[boneCount - 1].m_rotation.m_a;
+		}, repeatCount);
+
+		float fourWayDifference = largestDifference(result, fourWayReference);
+
+		std::string twoWayName = "  blendPoses (" + setName + "), 2 poses";
+		std::string fourWayName = "  blendPoses (" + setName + "), 4 poses";
+
+		printBenchmarkResult(twoWayName.c_str(), twoWay);
+		printBenchmarkSpeedup("    speedup against interpolate", perBone, twoWay);
+		printBenchmarkResult(fourWayName.c_str(), fourWay);
+		std::cout << "    largest difference to the scalar kernel " << std::defaultfloat
+				  << std::fmax(twoWayDifference, fourWayDifference) << std::endl;
+	}
+
+	LibMath::selectInstructionSet(activeSet);
+}
@@ -0,0 +1,83 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Skeleton.h"
+#include "../AnimationClip.h"
+#include "../CompressedClip.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <vector>
+#include <iostream>
+
+#pragma endregion
+
+namespace
+{
+	/// Compare the decoding cost of a compressed clip with the raw clip
+	void				measureClipSampling(const char* _name, AnimationClip const& _clip, CompressedClip const& _compressed)
+	{
+		const size_t sampleCount = 256;
+		const size_t repeatCount = 64;
+
+		std::vector<Transform> pose(_clip.m_boneCount);
+
+		BenchmarkResult raw = measure([&]()
+		{
+			for (size_t i = 0; i < sampleCount; ++i)
+			{
+				_clip.sampleTime(_clip.m_duration * float(i) / float(sampleCount), pose.data());
+			}
+			g_benchmarkSink = pose[1].m_position.m_x;
+		}, repeatCount, sampleCount);
+
+		BenchmarkResult compressed = measure([&]()
+		{
+			for (size_t i = 0; i < sampleCount; ++i)
+			{
+				_compressed.sampleTime(_compressed.m_duration * float(i) / float(sampleCount), pose.data());
+			}
+			g_benchmarkSink = pose[1].m_position.m_x;
+		}, repeatCount, sampleCount);
+
+		std::cout << _name << " sampling, one operation is a whole pose" << std::endl;
+		printBenchmarkResult("  raw sampleTime", raw);
+		printBenchmarkResult("  compressed sampleTime", compressed);
+	}
+}
+
+/// Compress the walk and run clips, report the ratio and the error of every bone then time the decoding
+void					runCompressionBenchmark()
+{
+	Skeleton skeleton;
+	AnimationClip walkClip;
+	AnimationClip runClip;
+
+	AnimationClip rawWalkClip;
+	AnimationClip rawRunClip;
+
+	/*The error is measured against every key of the files, before classifyTracks stores the channels within its
+	  tolerances once*/
+	if (!loadBenchmarkAssets(skeleton, walkClip, runClip) || 
+		!loadBenchmarkAssets(skeleton, rawWalkClip, rawRunClip, false))
+		return;
+
+	CompressedClip walkCompressed;
+	CompressedClip runCompressed;
+
+	walkCompressed.compress(walkClip);
+	runCompressed.compress(runClip);
+
+	printCompressionReport("ThirdPersonWalk.anim", rawWalkClip, walkClip, walkCompressed, skeleton);
+	printCompressionReport("ThirdPersonRun.anim", rawRunClip, runClip, runCompressed, skeleton);
+
+	measureClipSampling("ThirdPersonWalk.anim", walkClip, walkCompressed);
+	measureClipSampling("ThirdPersonRun.anim", runClip, runCompressed);
+}
@@ -0,0 +1,115 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Skeleton.h"
+#include "../AnimationClip.h"
+#include "../Crowd.h"
+#include "../ThreadPool.h"
+#include "../WorldPoseCache.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cmath>
+#include <vector>
+#include <string>
+#include <thread>
+#include <iostream>
+
+#pragma endregion
+
+namespace
+{
+	/// Largest distance between the bone positions of two crowds
+	float				largestPositionDifference(Crowd const& _lhs, Crowd const& _rhs)
+	{
+		float largest = 0.f;
+
+		for (size_t j = 0; j < _lhs.m_instances.size(); ++j)
+		{
+			std::vector<Transform> const& lhs = _lhs.m_instances[j].m_worldPose;
+			std::vector<Transform> const& rhs = _rhs.m_instances[j].m_worldPose;
+
+			for (size_t i = 0; i < lhs.size(); ++i)
+			{
+				LibMath::Vector3 offset = lhs[i].m_position - rhs[i].m_position;
+
+				largest = std::fmax(largest, std::sqrt(offset.m_x * offset.m_x + offset.m_y * offset.m_y + 
+													   offset.m_z * offset.m_z));
+			}
+		}
+
+		return largest;
+	}
+}
+
+/// Measure the crowd update on the calling thread, with the baked world poses and on thread pools of growing size
+void					runCrowdBenchmark()
+{
+	const size_t instanceCount = 1024;
+	const size_t repeatCount = 32;
+	const float frameTime = 1.f / 60.f;
+
+	Skeleton skeleton;
+	AnimationClip walkClip;
+	AnimationClip runClip;
+
+	if (!loadBenchmarkAssets(skeleton, walkClip, runClip))
+		return;
+
+	Crowd crowd;
+	crowd.initialize(skeleton, { &walkClip, &runClip }, instanceCount);
+
+	unsigned int coreCount = std::thread::hardware_concurrency();
+
+	std::cout << "Crowd (" << instanceCount << " characters, " << skeleton.m_boneCount << " bones, " 
+			  << coreCount << " cores)" << std::endl;
+
+	BenchmarkResult serial = measure([&]()
+	{
+		crowd.update(frameTime);
+		g_benchmarkSink = crowd.m_instances[instanceCount - 1].m_palette[0].m_matrix[3][0];
+	}, repeatCount, instanceCount);
+
+	printBenchmarkResult("  serial", serial);
+
+	/*Same characters reading the baked world poses instead of sampling and walking the hierarchy*/
+	WorldPoseCache poseCache;
+	poseCache.bake(skeleton, { &walkClip, &runClip }, WorldPoseCache::bakedSize(walkClip) + WorldPoseCache::bakedSize(runClip));
+
+	Crowd bakedCrowd;
+	bakedCrowd.initialize(skeleton, { &walkClip, &runClip }, instanceCount, PaletteFormat::Matrix4, &poseCache);
+
+	BenchmarkResult baked = measure([&]()
+	{
+		bakedCrowd.update(frameTime);
+		g_benchmarkSink = bakedCrowd.m_instances[instanceCount - 1].m_palette[0].m_matrix[3][0];
+	}, repeatCount, instanceCount);
+
+	std::cout << "  baked world poses : " << poseCache.footprint() << " bytes, largest bone distance " 
+			  << largestPositionDifference(crowd, bakedCrowd) << std::endl;
+
+	printBenchmarkResult("  serial baked", baked);
+	printBenchmarkSpeedup("  speedup baked", serial, baked);
+
+	forEachThreadCount(coreCount, [&](size_t _threadCount, ThreadPool& _pool)
+	{
+		BenchmarkResult parallel = measure([&]()
+		{
+			crowd.update(frameTime, _pool);
+			g_benchmarkSink = crowd.m_instances[instanceCount - 1].m_palette[0].m_matrix[3][0];
+		}, repeatCount, instanceCount);
+
+		std::string name = "  pool " + std::to_string(_threadCount) + " threads";
+		std::string speedupName = "  speedup " + std::to_string(_threadCount) + " threads";
+
+		printBenchmarkResult(name.c_str(), parallel);
+		printBenchmarkSpeedup(speedupName.c_str(), serial, parallel);
+	});
+}
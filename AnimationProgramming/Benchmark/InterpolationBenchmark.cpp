@@ -0,0 +1,213 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Skeleton.h"
+#include "../AnimationClip.h"
+
+#pragma endregion
+
+#pragma region LibMath
+
+#include "Quaternion.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include <random>
+#include <string>
+#include <iostream>
+
+#pragma endregion
+
+namespace
+{
+	const LibMath::RotationInterpolation g_interpolations[] = 
+	{
+		LibMath::RotationInterpolation::Slerp,
+		LibMath::RotationInterpolation::ApproximateSlerp,
+		LibMath::RotationInterpolation::Nlerp
+	};
+
+	/// Slerp computed in double precision as the reference
+	void				referenceSlerp(LibMath::Quaternion const& _quat1, LibMath::Quaternion const& _quat2, double _t, 
+									   double _result[4])
+	{
+		double lhs[4] = { _quat1.m_a, _quat1.m_b, _quat1.m_c, _quat1.m_d };
+		double rhs[4] = { _quat2.m_a, _quat2.m_b, _quat2.m_c, _quat2.m_d };
+
+		double dot = lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2] + lhs[3] * rhs[3];
+		double sign = dot < 0.0 ? -1.0 : 1.0;
+		dot = std::fmin(std::fabs(dot), 1.0);
+
+		double omega = std::acos(dot);
+		double scale0 = 1.0 - _t;
+		double scale1 = _t;
+
+		if (omega > 1e-9)
+		{
+			scale0 = std::sin((1.0 - _t) * omega) / std::sin(omega);
+			scale1 = std::sin(_t * omega) / std::sin(omega);
+		}
+
+		for (int i = 0; i < 4; ++i)
+		{
+			_result[i] = scale0 * lhs[i] + scale1 * sign * rhs[i];
+		}
+	}
+
+	/// Angle in degrees between a rotation and the reference
+	double				angleToReference(LibMath::Quaternion const& _rotation, double const _reference[4])
+	{
+		double rotation[4] = { _rotation.m_a, _rotation.m_b, _rotation.m_c, _rotation.m_d };
+
+		double dot = 0.0;
+		double rotationLength = 0.0;
+		double referenceLength = 0.0;
+
+		for (int i = 0; i < 4; ++i)
+		{
+			dot += rotation[i] * _reference[i];
+			rotationLength += rotation[i] * rotation[i];
+			referenceLength += _reference[i] * _reference[i];
+		}
+
+		dot = std::fmin(std::fabs(dot) / std::sqrt(rotationLength * referenceLength), 1.0);
+
+		return 2.0 * std::acos(dot) * 57.29577951308232;
+	}
+
+	/// Create pairs of rotations separated by at most _maxAngle degrees
+	void				createRotationPairs(size_t _count, float _maxAngle, std::vector<LibMath::Quaternion>& _starts,
+											std::vector<LibMath::Quaternion>& _ends)
+	{
+		std::mt19937 generator(11);
+		std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+		_starts.resize(_count);
+		_ends.resize(_count);
+
+		for (size_t i = 0; i < _count; ++i)
+		{
+			_starts[i] = LibMath::normalize(LibMath::Quaternion(distribution(generator), distribution(generator), 
+																distribution(generator), distribution(generator)));
+
+			/*Rotate the start by a random axis and angle*/
+			LibMath::Vector3 axis(distribution(generator), distribution(generator), distribution(generator));
+			float axisLength = std::sqrt(axis.m_x * axis.m_x + axis.m_y * axis.m_y + axis.m_z * axis.m_z);
+			float halfAngle = 0.5f * _maxAngle * 0.0174532925f * (0.5f + 0.5f * distribution(generator));
+			float sinHalfAngle = std::sin(halfAngle) / axisLength;
+
+			LibMath::Quaternion delta(std::cos(halfAngle), axis.m_x * sinHalfAngle, axis.m_y * sinHalfAngle, 
+									  axis.m_z * sinHalfAngle);
+
+			_ends[i] = _starts[i] * delta;
+		}
+	}
+
+	/// Largest error against slerp in double precision over several parameters
+	double				measureInterpolationError(std::vector<LibMath::Quaternion> const& _starts, 
+												  std::vector<LibMath::Quaternion> const& _ends, 
+												  LibMath::RotationInterpolation _interpolation)
+	{
+		double largestError = 0.0;
+
+		for (size_t i = 0; i < _starts.size(); ++i)
+		{
+			for (int step = 1; step < 16; ++step)
+			{
+				float t = float(step) / 16.f;
+
+				double reference[4];
+				referenceSlerp(_starts[i], _ends[i], t, reference);
+
+				LibMath::Quaternion rotation = LibMath::interpolateRotation(_starts[i], _ends[i], t, _interpolation);
+
+				largestError = std::fmax(largestError, angleToReference(rotation, reference));
+			}
+		}
+
+		return largestError;
+	}
+}
+
+/// Compare the cost and the accuracy of slerp, approximate slerp and nlerp, alone and when sampling the walk clip
+void					runInterpolationBenchmark()
+{
+	const size_t count = 4096;
+	const size_t repeatCount = 64;
+	const float maxAngles[] = { 12.f, 90.f, 180.f };
+
+	std::vector<LibMath::Quaternion> starts;
+	std::vector<LibMath::Quaternion> ends;
+	std::vector<LibMath::Quaternion> results(count);
+
+	std::cout << "Rotation interpolation, error against slerp in double precision" << std::endl;
+
+	for (float maxAngle : maxAngles)
+	{
+		createRotationPairs(count, maxAngle, starts, ends);
+
+		std::cout << "  pairs up to " << int(maxAngle) << " degrees apart" << std::endl;
+
+		for (LibMath::RotationInterpolation interpolation : g_interpolations)
+		{
+			double error = measureInterpolationError(starts, ends, interpolation);
+
+			BenchmarkResult result = measure([&]()
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					results[i] = LibMath::interpolateRotation(starts[i], ends[i], 0.3f, interpolation);
+				}
+				g_benchmarkSink = results[count - 1].m_a;
+			}, repeatCount, count);
+
+			char name[64];
+			std::snprintf(name, sizeof(name), "    %s, error %.4f deg", 
+						  LibMath::rotationInterpolationName(interpolation), error);
+
+			printBenchmarkResult(name, result);
+		}
+	}
+
+	Skeleton skeleton;
+	AnimationClip walkClip;
+	AnimationClip runClip;
+
+	if (!loadBenchmarkAssets(skeleton, walkClip, runClip))
+		return;
+
+	/*Keys 1/30 s apart are the real use case*/
+	const size_t sampleCount = 256;
+
+	std::vector<Transform> pose(walkClip.m_boneCount);
+
+	std::cout << "  ThirdPersonWalk.anim sampling, one operation is a whole pose" << std::endl;
+
+	for (LibMath::RotationInterpolation interpolation : g_interpolations)
+	{
+		walkClip.m_rotationInterpolation = interpolation;
+
+		BenchmarkResult result = measure([&]()
+		{
+			for (size_t i = 0; i < sampleCount; ++i)
+			{
+				walkClip.sampleTime(walkClip.m_duration * float(i) / float(sampleCount), pose.data());
+			}
+			g_benchmarkSink = pose[1].m_rotation.m_a;
+		}, repeatCount, sampleCount);
+
+		std::string name = std::string("    ") + LibMath::rotationInterpolationName(interpolation);
+
+		printBenchmarkResult(name.c_str(), result);
+	}
+}
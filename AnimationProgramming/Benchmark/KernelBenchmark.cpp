@@ -0,0 +1,222 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Transform.h"
+
+#pragma endregion
+
+#pragma region LibMath
+
+#include "Matrix/Matrix4.h"
+#include "Quaternion.h"
+#include "SIMD.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+#pragma endregion
+
+namespace
+{
+	/// Batch sizes measured for every kernel
+	const size_t	g_batchSizes[] = { 1, 64, 4096 };
+	/// Operations done per measure so every batch size runs for about the same time
+	const size_t	g_operationBudget = 1 << 20;
+
+	/// Measure a kernel processing the first _count elements of its data for every batch size
+	template <typename Kernel>
+	void				measureBatches(const char* _name, Kernel _kernel)
+	{
+		for (size_t batchSize : g_batchSizes)
+		{
+			BenchmarkResult result = measure([&]()
+			{
+				_kernel(batchSize);
+			}, g_operationBudget / batchSize, batchSize);
+
+			std::string name = std::string("  ") + _name + " x" + std::to_string(batchSize);
+
+			printBenchmarkResult(name.c_str(), result);
+		}
+	}
+}
+
+/// Measure the animation hot kernels alone and in batches of 1, 64 and 4096 elements
+void					runKernelBenchmark()
+{
+	const size_t count = 4096;
+
+	std::vector<Transform> transforms = createRandomTransforms(count, 1.f, 42);
+	std::vector<Transform> otherTransforms = createRandomTransforms(count, 1.f, 7);
+
+	std::vector<LibMath::Matrix4> matrices(count);
+	std::vector<LibMath::Matrix4> otherMatrices(count);
+	std::vector<LibMath::Matrix4> resultMatrices(count);
+	std::vector<LibMath::Quaternion> resultQuaternions(count);
+	std::vector<LibMath::Vector3> resultVectors(count);
+	std::vector<Transform> resultTransforms(count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		matrices[i] = transformToMatrix4(transforms[i]);
+		otherMatrices[i] = transformToMatrix4(otherTransforms[i]);
+	}
+
+	std::cout << "Kernels (" << LibMath::instructionSetName(LibMath::activeInstructionSet()) << ")" << std::endl;
+
+	measureBatches("Matrix4 * Matrix4", [&](size_t _count)
+	{
+		for (size_t i = 0; i < _count; ++i)
+		{
+			resultMatrices[i] = matrices[i] * otherMatrices[i];
+		}
+		g_benchmarkSink = resultMatrices[_count - 1].m_matrix[3][0];
+	});
+
+	measureBatches("Matrix4::GetInverse", [&](size_t _count)
+	{
+		for (size_t i = 0; i < _count; ++i)
+		{
+			resultMatrices[i] = matrices[i].GetInverse();
+		}
+		g_benchmarkSink = resultMatrices[_count - 1].m_matrix[3][0];
+	});
+
+	measureBatches("slerp", [&](size_t _count)
+	{
+		for (size_t i = 0; i < _count; ++i)
+		{
+			resultQuaternions[i] = LibMath::slerp(transforms[i].m_rotation, otherTransforms[i].m_rotation, 0.3f);
+		}
+		g_benchmarkSink = resultQuaternions[_count - 1].m_a;
+	});
+
+	measureBatches("Vector3 * Quaternion", [&](size_t _count)
+	{
+		for (size_t i = 0; i < _count; ++i)
+		{
+			resultVectors[i] = transforms[i].m_position * otherTransforms[i].m_rotation;
+		}
+		g_benchmarkSink = resultVectors[_count - 1].m_x;
+	});
+
+	measureBatches("rotate by quaternion products", [&](size_t _count)
+	{
+		for (size_t i = 0; i < _count; ++i)
+		{
+			LibMath::Vector3 const& position = transforms[i].m_position;
+			LibMath::Quaternion const& rotation = otherTransforms[i].m_rotation;
+
+			LibMath::Quaternion result = (rotation * LibMath::Quaternion(0.f, position.m_x, position.m_y, position.m_z)) * 
+										 LibMath::conjugate(rotation);
+
+			resultVectors[i] = LibMath::Vector3(result.m_b, result.m_c, result.m_d);
+		}
+		g_benchmarkSink = resultVectors[_count - 1].m_x;
+	});
+
+	measureBatches("toMatrix4(Quaternion)", [&](size_t _count)
+	{
+		for (size_t i = 0; i < _count; ++i)
+		{
+			resultMatrices[i] = LibMath::toMatrix4(transforms[i].m_rotation);
+		}
+		g_benchmarkSink = resultMatrices[_count - 1].m_matrix[0][0];
+	});
+
+	measureBatches("transformToMatrix4", [&](size_t _count)
+	{
+		for (size_t i = 0; i < _count; ++i)
+		{
+			resultMatrices[i] = transformToMatrix4(transforms[i]);
+		}
+		g_benchmarkSink = resultMatrices[_count - 1].m_matrix[3][0];
+	});
+
+	measureBatches("interpolate(Transform)", [&](size_t _count)
+	{
+		for (size_t i = 0; i < _count; ++i)
+		{
+			resultTransforms[i] = interpolate(transforms[i], otherTransforms[i], 0.3f);
+		}
+		g_benchmarkSink = resultTransforms[_count - 1].m_position.m_x;
+	});
+
+	/*Split the data in component arrays for the batched rotate*/
+	std::vector<float> rotationComponents[4];
+	std::vector<float> positionComponents[3];
+	std::vector<float> resultComponents[3];
+	std::vector<float> scaleComponents[3];
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		rotationComponents[0].push_back(otherTransforms[i].m_rotation.m_a);
+		rotationComponents[1].push_back(otherTransforms[i].m_rotation.m_b);
+		rotationComponents[2].push_back(otherTransforms[i].m_rotation.m_c);
+		rotationComponents[3].push_back(otherTransforms[i].m_rotation.m_d);
+		positionComponents[0].push_back(transforms[i].m_position.m_x);
+		positionComponents[1].push_back(transforms[i].m_position.m_y);
+		positionComponents[2].push_back(transforms[i].m_position.m_z);
+		resultComponents[0].push_back(0.f);
+		resultComponents[1].push_back(0.f);
+		resultComponents[2].push_back(0.f);
+		scaleComponents[0].push_back(transforms[i].m_scale.m_x);
+		scaleComponents[1].push_back(transforms[i].m_scale.m_y);
+		scaleComponents[2].push_back(transforms[i].m_scale.m_z);
+	}
+
+	LibMath::QuaternionArrays rotations = { rotationComponents[0].data(), rotationComponents[1].data(), 
+											rotationComponents[2].data(), rotationComponents[3].data() };
+	LibMath::Vector3Arrays positions = { positionComponents[0].data(), positionComponents[1].data(), 
+										 positionComponents[2].data() };
+	LibMath::Vector3Arrays rotatedPositions = { resultComponents[0].data(), resultComponents[1].data(), 
+												resultComponents[2].data() };
+
+	TransformArrays transformArrays = { positions, rotations, { scaleComponents[0].data(), scaleComponents[1].data(), 
+																 scaleComponents[2].data() } };
+
+	/*Compare the batched kernels on every instruction set the processor supports*/
+	LibMath::InstructionSet activeSet = LibMath::activeInstructionSet();
+	LibMath::InstructionSet supportedSet = LibMath::detectInstructionSet();
+
+	for (int set = 0; set <= static_cast<int>(supportedSet); ++set)
+	{
+		LibMath::InstructionSet instructionSet = LibMath::selectInstructionSet(static_cast<LibMath::InstructionSet>(set));
+
+		std::string name = std::string("multiply batch (") + LibMath::instructionSetName(instructionSet) + ")";
+
+		measureBatches(name.c_str(), [&](size_t _count)
+		{
+			LibMath::multiply(matrices.data(), otherMatrices.data(), resultMatrices.data(), _count);
+			g_benchmarkSink = resultMatrices[_count - 1].m_matrix[3][0];
+		});
+
+		name = std::string("rotate batch (") + LibMath::instructionSetName(instructionSet) + ")";
+
+		measureBatches(name.c_str(), [&](size_t _count)
+		{
+			LibMath::rotate(rotations, positions, rotatedPositions, _count);
+			g_benchmarkSink = rotatedPositions.m_x[_count - 1];
+		});
+
+		name = std::string("transformToMatrix4 batch (") + LibMath::instructionSetName(instructionSet) + ")";
+
+		measureBatches(name.c_str(), [&](size_t _count)
+		{
+			transformToMatrix4(transformArrays, resultMatrices.data(), _count);
+			g_benchmarkSink = resultMatrices[_count - 1].m_matrix[3][0];
+		});
+	}
+
+	LibMath::selectInstructionSet(activeSet);
+}
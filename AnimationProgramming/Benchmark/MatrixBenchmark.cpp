@@ -0,0 +1,130 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Transform.h"
+
+#pragma endregion
+
+#pragma region LibMath
+
+#include "Matrix/Matrix4.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <vector>
+#include <iostream>
+
+#pragma endregion
+
+namespace
+{
+	/// Return the biggest component difference between two matrices
+	float					maxDifference(LibMath::Matrix4 const& _lhs, LibMath::Matrix4 const& _rhs)
+	{
+		float difference = 0.f;
+
+		for (int i = 0; i < 16; ++i)
+		{
+			float delta = _lhs.m_matrix[i / 4][i % 4] - _rhs.m_matrix[i / 4][i % 4];
+			delta = delta < 0.f ? -delta : delta;
+			difference = delta > difference ? delta : difference;
+		}
+
+		return difference;
+	}
+}
+
+/// Compare the closed-form Matrix4 and Transform inverses with the generic adjugate inverse
+void					runMatrixInverseBenchmark()
+{
+	const size_t count = 4096;
+	const size_t repeatCount = 64;
+
+	std::vector<Transform> rigidTransforms = createRandomTransforms(count, 1.f);
+	std::vector<Transform> affineTransforms = createRandomTransforms(count, 1.5f);
+
+	std::vector<LibMath::Matrix4> rigidMatrices(count);
+	std::vector<LibMath::Matrix4> affineMatrices(count);
+	std::vector<LibMath::Matrix4> results(count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		rigidMatrices[i] = transformToMatrix4(rigidTransforms[i]);
+		affineMatrices[i] = transformToMatrix4(affineTransforms[i]);
+	}
+
+	/*Check the closed forms against the generic inverse before timing them*/
+	float rigidError = 0.f;
+	float affineError = 0.f;
+	float transformError = 0.f;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		LibMath::Matrix4 reference = rigidMatrices[i].GetInverse();
+		float error = maxDifference(reference, rigidMatrices[i].GetRigidInverse());
+		rigidError = error > rigidError ? error : rigidError;
+
+		error = maxDifference(reference, transformToMatrix4(inverse(rigidTransforms[i])));
+		transformError = error > transformError ? error : transformError;
+
+		error = maxDifference(affineMatrices[i].GetInverse(), affineMatrices[i].GetAffineInverse());
+		affineError = error > affineError ? error : affineError;
+	}
+
+	std::cout << "Matrix4 inverse (" << count << " matrices)" << std::endl;
+	std::cout << "  max error rigid " << rigidError << ", affine " << affineError 
+			  << ", transform " << transformError << std::endl;
+
+	BenchmarkResult generic = measure([&]()
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			results[i] = affineMatrices[i].GetInverse();
+		}
+		g_benchmarkSink = results[count - 1].m_matrix[3][0];
+	}, repeatCount, count);
+
+	BenchmarkResult affine = measure([&]()
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			results[i] = affineMatrices[i].GetAffineInverse();
+		}
+		g_benchmarkSink = results[count - 1].m_matrix[3][0];
+	}, repeatCount, count);
+
+	BenchmarkResult rigid = measure([&]()
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			results[i] = rigidMatrices[i].GetRigidInverse();
+		}
+		g_benchmarkSink = results[count - 1].m_matrix[3][0];
+	}, repeatCount, count);
+
+	std::vector<Transform> inverseTransforms(count);
+
+	BenchmarkResult transform = measure([&]()
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			inverseTransforms[i] = inverse(rigidTransforms[i]);
+		}
+		g_benchmarkSink = inverseTransforms[count - 1].m_position.m_x;
+	}, repeatCount, count);
+
+	printBenchmarkResult("  Matrix4::GetInverse", generic);
+	printBenchmarkResult("  Matrix4::GetAffineInverse", affine);
+	printBenchmarkResult("  Matrix4::GetRigidInverse", rigid);
+	printBenchmarkResult("  inverse(Transform)", transform);
+	printBenchmarkSpeedup("  speedup affine", generic, affine);
+	printBenchmarkSpeedup("  speedup rigid", generic, rigid);
+	printBenchmarkSpeedup("  speedup transform", generic, transform);
+}
@@ -0,0 +1,126 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Skeleton.h"
+#include "../AnimationClip.h"
+#include "../Crowd.h"
+#include "../ThreadPool.h"
+#include "../TaskGraph.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstring>
+#include <vector>
+#include <string>
+#include <thread>
+#include <iostream>
+
+#pragma endregion
+
+/// Run the frame of a crowd serially, then as a task graph with the submission on the calling thread, on thread pools of growing size
+void					runPipelineBenchmark()
+{
+	const size_t instanceCount = 1024;
+	const size_t repeatCount = 32;
+	const float frameTime = 1.f / 60.f;
+
+	Skeleton skeleton;
+	AnimationClip walkClip;
+	AnimationClip runClip;
+
+	if (!loadBenchmarkAssets(skeleton, walkClip, runClip))
+		return;
+
+	Crowd crowd;
+	crowd.initialize(skeleton, { &walkClip, &runClip }, instanceCount);
+
+	/*Stands for SetSkinningPose : every palette is copied to one buffer by the calling thread*/
+	const size_t paletteSize = paletteSubmitCount(PaletteFormat::Matrix4, skeleton.m_boneCount) * sizeof(float);
+	std::vector<float> submitted(paletteSubmitCount(PaletteFormat::Matrix4, skeleton.m_boneCount));
+
+	auto submit = [&](size_t _begin, size_t _end)
+	{
+		for (size_t i = _begin; i < _end; ++i)
+		{
+			std::memcpy(submitted.data(), crowd.m_instances[i].paletteData(), paletteSize);
+		}
+	};
+
+	unsigned int coreCount = std::thread::hardware_concurrency();
+
+	std::cout << "Frame pipeline (" << instanceCount << " characters, " << skeleton.m_boneCount << " bones, "
+			  << coreCount << " cores), advance, sample, FK, palette and submission" << std::endl;
+
+	BenchmarkResult serial = measure([&]()
+	{
+		for (AnimationInstance& instance : crowd.m_instances)
+		{
+			instance.advance(frameTime);
+			instance.evaluate();
+		}
+
+		submit(0, instanceCount);
+		g_benchmarkSink = submitted[12];
+	}, repeatCount, instanceCount);
+
+	printBenchmarkResult("  serial", serial);
+
+	forEachThreadCount(coreCount, [&](size_t _threadCount, ThreadPool& _pool)
+	{
+		/*Every stage waits for the previous one on every character*/
+		BenchmarkResult parallelFor = measure([&]()
+		{
+			crowd.update(frameTime, _pool);
+
+			submit(0, instanceCount);
+			g_benchmarkSink = submitted[12];
+		}, repeatCount, instanceCount);
+
+		/*A group is submitted as soon as its palettes are built, in the order of the characters*/
+		TaskGraph graph;
+		std::vector<size_t> poseTasks;
+		std::vector<size_t> paletteTasks;
+
+		crowd.addFrameTasks(graph, poseTasks, paletteTasks);
+
+		size_t previousTask = paletteTasks[0];
+
+		for (size_t group = 0; group < paletteTasks.size(); ++group)
+		{
+			size_t begin = group * crowd.m_grainSize;
+			size_t end = begin + crowd.m_grainSize < instanceCount ? begin + crowd.m_grainSize : instanceCount;
+
+			size_t submitTask = graph.addTask([&submit, begin, end]() { submit(begin, end); }, TaskThread::Caller);
+
+			graph.addDependency(paletteTasks[group], submitTask);
+
+			if (group > 0)
+			{
+				graph.addDependency(previousTask, submitTask);
+			}
+
+			previousTask = submitTask;
+		}
+
+		BenchmarkResult taskGraph = measure([&]()
+		{
+			crowd.update(frameTime, graph, _pool);
+			g_benchmarkSink = submitted[12];
+		}, repeatCount, instanceCount);
+
+		std::string parallelForName = "  parallelFor " + std::to_string(_threadCount) + " threads";
+		std::string graphName = "  task graph " + std::to_string(_threadCount) + " threads";
+
+		printBenchmarkResult(parallelForName.c_str(), parallelFor);
+		printBenchmarkSpeedup("    speedup against serial", serial, parallelFor);
+		printBenchmarkResult(graphName.c_str(), taskGraph);
+		printBenchmarkSpeedup("    speedup against serial", serial, taskGraph);
+	});
+}
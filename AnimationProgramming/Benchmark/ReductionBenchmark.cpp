@@ -0,0 +1,138 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Skeleton.h"
+#include "../AnimationClip.h"
+#include "../ReducedClip.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cmath>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+#pragma endregion
+
+namespace
+{
+	/// Largest object space position error of a reduced clip, sampled on the keys and half way between them
+	float				measureObjectSpaceError(AnimationClip const& _clip, ReducedClip const& _reduced, 
+												Skeleton const& _skeleton)
+	{
+		std::vector<Transform> rawPose(_clip.m_boneCount);
+		std::vector<Transform> reducedPose(_clip.m_boneCount);
+		std::vector<Transform> rawWorldPose(_clip.m_boneCount);
+		std::vector<Transform> reducedWorldPose(_clip.m_boneCount);
+
+		size_t sampleCount = _clip.m_keyCount * 2;
+		float largestError = 0.f;
+
+		ReducedClipCursor cursor;
+
+		for (size_t j = 0; j < sampleCount; ++j)
+		{
+			float time = _clip.m_duration * float(j) / float(sampleCount - 1);
+
+			_clip.sampleTime(time, rawPose.data());
+			_reduced.sampleTime(time, reducedPose.data(), cursor);
+
+			_skeleton.computeWorldPose(rawPose.data(), rawWorldPose.data());
+			_skeleton.computeWorldPose(reducedPose.data(), reducedWorldPose.data());
+
+			for (size_t i = 0; i < _clip.m_boneCount; ++i)
+			{
+				LibMath::Vector3 const& raw = rawWorldPose[i].m_position;
+				LibMath::Vector3 const& reduced = reducedWorldPose[i].m_position;
+
+				float x = raw.m_x - reduced.m_x;
+				float y = raw.m_y - reduced.m_y;
+				float z = raw.m_z - reduced.m_z;
+
+				largestError = std::fmax(largestError, std::sqrt(x * x + y * y + z * z));
+			}
+		}
+
+		return largestError;
+	}
+
+	/// Reduce a clip with growing tolerances and report the kept keys, the memory, the error and the sampling cost
+	void				reportReduction(const char* _name, AnimationClip const& _clip, Skeleton const& _skeleton)
+	{
+		const float tolerances[] = { 0.01f, 0.1f, 1.f, 5.f };
+		const size_t sampleCount = 256;
+		const size_t repeatCount = 64;
+
+		/*Only the tracks left by the classification are reduced, the translation tracks also hold the scale*/
+		size_t sourceKeyCount = (_clip.m_rotationBones.size() + _clip.m_translationBones.size() * 2) * _clip.m_keyCount;
+
+		std::cout << _name << " : " << sourceKeyCount << " animated keys, " << _clip.footprint() << " bytes classified"
+				  << std::endl;
+
+		std::vector<Transform> pose(_clip.m_boneCount);
+
+		BenchmarkResult raw = measure([&]()
+		{
+			for (size_t i = 0; i < sampleCount; ++i)
+			{
+				_clip.sampleTime(_clip.m_duration * float(i) / float(sampleCount), pose.data());
+			}
+			g_benchmarkSink = pose[1].m_position.m_x;
+		}, repeatCount, sampleCount);
+
+		printBenchmarkResult("  raw sampleTime", raw);
+
+		for (float tolerance : tolerances)
+		{
+			ReductionSettings settings;
+			settings.m_positionTolerance = tolerance;
+
+			ReducedClip reduced;
+			reduced.reduce(_clip, _skeleton, settings);
+
+			float error = measureObjectSpaceError(_clip, reduced, _skeleton);
+
+			std::cout << "  tolerance " << tolerance << " : " << reduced.keptKeyCount() << " keys kept, " 
+					  << reduced.footprint() << " bytes (" << std::fixed << std::setprecision(1) 
+					  << 100.0 * double(reduced.footprint()) / double(_clip.footprint()) << " %), max error " 
+					  << std::setprecision(4) << error << std::endl;
+			std::cout.unsetf(std::ios_base::fixed);
+
+			/*The samples go forward through the clip like a playback, the cursor restarts once per loop*/
+			ReducedClipCursor cursor;
+
+			BenchmarkResult sampling = measure([&]()
+			{
+				for (size_t i = 0; i < sampleCount; ++i)
+				{
+					reduced.sampleTime(reduced.m_duration * float(i) / float(sampleCount), pose.data(), cursor);
+				}
+				g_benchmarkSink = pose[1].m_position.m_x;
+			}, repeatCount, sampleCount);
+
+			printBenchmarkResult("  reduced sampleTime", sampling);
+		}
+	}
+}
+
+/// Reduce the walk and run clips with several tolerances and report the savings, the error and the sampling cost
+void					runReductionBenchmark()
+{
+	Skeleton skeleton;
+	AnimationClip walkClip;
+	AnimationClip runClip;
+
+	if (!loadBenchmarkAssets(skeleton, walkClip, runClip))
+		return;
+
+	reportReduction("ThirdPersonWalk.anim", walkClip, skeleton);
+	reportReduction("ThirdPersonRun.anim", runClip, skeleton);
+}
@@ -0,0 +1,167 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Skeleton.h"
+#include "../AnimationClip.h"
+#include "../AnimationInstance.h"
+#include "../ResourceFile.h"
+#include "../Skinning.h"
+#include "../ThreadPool.h"
+
+#pragma endregion
+
+#pragma region LibMath
+
+#include "LibMath/Header/SIMD.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cmath>
+#include <vector>
+#include <string>
+#include <thread>
+#include <iostream>
+
+#pragma endregion
+
+namespace
+{
+	/// Positions written by the batched skinning, one array per coordinate
+	struct SkinnedPositions
+	{
+		std::vector<float>		m_components[3];
+
+		explicit				SkinnedPositions(size_t _count)
+		{
+			for (std::vector<float>& component : m_components)
+			{
+				component.resize(_count);
+			}
+		}
+
+		LibMath::Vector3Arrays	arrays() { return { m_components[0].data(), m_components[1].data(), m_components[2].data() }; }
+	};
+
+	/// Largest distance between the batched positions and skinVertex
+	float					largestDistance(const MeshVertex* _vertices, size_t _count, const LibMath::Matrix4* _palette,
+											SkinnedPositions const& _positions)
+	{
+		float largest = 0.f;
+
+		for (size_t i = 0; i < _count; ++i)
+		{
+			LibMath::Vector3 reference = skinVertex(_vertices[i], _palette);
+
+			float x = _positions.m_components[0][i] - reference.m_x;
+			float y = _positions.m_components[1][i] - reference.m_y;
+			float z = _positions.m_components[2][i] - reference.m_z;
+
+			largest = std::fmax(largest, std::sqrt(x * x + y * y + z * z));
+		}
+
+		return largest;
+	}
+
+	/// Print the vertices per second of a result and the characters per second it makes
+	void					printVertexRate(const char* _name, BenchmarkResult const& _result, size_t _vertexCount)
+	{
+		printBenchmarkResult(_name, _result);
+
+		std::cout << "    " << _result.m_operationsPerSecond / 1e6 << " M vertices/s, "
+				  << _result.m_operationsPerSecond / double(_vertexCount) << " characters/s" << std::endl;
+	}
+}
+
+/// Skin SK_Mannequin.msh on the CPU with every instruction set and thread count and report the vertices per second
+void					runSkinningBenchmark()
+{
+	const size_t repeatCount = 64;
+
+	Skeleton skeleton;
+	AnimationClip walkClip;
+	AnimationClip runClip;
+	MeshFile mesh;
+
+	if (!loadBenchmarkAssets(skeleton, walkClip, runClip) || !openBenchmarkMesh(mesh))
+		return;
+
+	/*A posed palette, not the identity, so every influence moves the vertices*/
+	AnimationInstance instance;
+	instance.initialize(skeleton, runClip, runClip.m_duration * 0.37f);
+	instance.evaluate();
+
+	const MeshVertex* vertices = mesh.vertices();
+	const size_t vertexCount = mesh.vertexCount();
+	const LibMath::Matrix4* palette = instance.m_palette.data();
+
+	SkinnedPositions positions(vertexCount);
+	LibMath::Vector3Arrays positionArrays = positions.arrays();
+
+	unsigned int coreCount = std::thread::hardware_concurrency();
+
+	std::cout << "CPU skinning (" << vertexCount << " vertices, " << vertexCount * sizeof(MeshVertex) / 1024
+			  << " KB, " << skeleton.m_boneCount << " bones, " << coreCount << " cores)" << std::endl;
+
+	BenchmarkResult reference = measure([&]()
+	{
+		for (size_t i = 0; i < vertexCount; ++i)
+		{
+			g_benchmarkSink = skinVertex(vertices[i], palette).m_x;
+		}
+	}, repeatCount, vertexCount);
+
+	printVertexRate("  skinVertex", reference, vertexCount);
+
+	/*Every kernel the processor supports, on the calling thread*/
+	LibMath::InstructionSet activeSet = LibMath::activeInstructionSet();
+	LibMath::InstructionSet supportedSet = LibMath::detectInstructionSet();
+
+	for (int set = 0; set <= static_cast<int>(supportedSet); ++set)
+	{
+		LibMath::InstructionSet instructionSet = LibMath::selectInstructionSet(static_cast<LibMath::InstructionSet>(set));
+
+		BenchmarkResult batch = measure([&]()
+		{
+			skinVertices(vertices, vertexCount, palette, positionArrays);
+			g_benchmarkSink = positionArrays.m_x[vertexCount - 1];
+		}, repeatCount, vertexCount);
+
+		std::string name = std::string("  skinVertices (") + LibMath::instructionSetName(instructionSet) + ")";
+
+		printVertexRate(name.c_str(), batch, vertexCount);
+		std::cout << "    largest distance to skinVertex " << std::defaultfloat
+				  << largestDistance(vertices, vertexCount, palette, positions) << std::endl;
+	}
+
+	LibMath::selectInstructionSet(activeSet);
+
+	BenchmarkResult serial = measure([&]()
+	{
+		skinVertices(vertices, vertexCount, palette, positionArrays);
+		g_benchmarkSink = positionArrays.m_x[vertexCount - 1];
+	}, repeatCount, vertexCount);
+
+	printVertexRate("  serial", serial, vertexCount);
+
+	forEachThreadCount(coreCount, [&](size_t _threadCount, ThreadPool& _pool)
+	{
+		BenchmarkResult parallel = measure([&]()
+		{
+			skinVertices(vertices, vertexCount, palette, positionArrays, _pool);
+			g_benchmarkSink = positionArrays.m_x[vertexCount - 1];
+		}, repeatCount, vertexCount);
+
+		std::string name = "  pool " + std::to_string(_threadCount) + " threads";
+		std::string speedupName = "  speedup " + std::to_string(_threadCount) + " threads";
+
+		printVertexRate(name.c_str(), parallel, vertexCount);
+		printBenchmarkSpeedup(speedupName.c_str(), serial, parallel);
+	});
+}
@@ -0,0 +1,139 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Skeleton.h"
+#include "../AnimationClip.h"
+#include "../AnimationStateMachine.h"
+#include "../PoseBlend.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cmath>
+#include <vector>
+#include <iostream>
+
+#pragma endregion
+
+/// Tick a walk and run state machine for thousands of characters, then sample their active states
+void					runStateMachineBenchmark()
+{
+	const size_t instanceCount = 4096;
+	const size_t frameCount = 64;
+	const float frameTime = 1.f / 60.f;
+
+	Skeleton skeleton;
+	AnimationClip walkClip;
+	AnimationClip runClip;
+
+	if (!loadBenchmarkAssets(skeleton, walkClip, runClip))
+		return;
+
+	const size_t boneCount = skeleton.m_boneCount;
+
+	StateMachineDefinition definition;
+	size_t walk = definition.addState("walk", walkClip);
+	size_t run = definition.addState("run", runClip);
+	size_t speed = definition.addParameter("speed");
+
+	StateTransition toRun;
+	toRun.m_from = walk;
+	toRun.m_to = run;
+	toRun.m_condition = { ConditionType::Greater, speed, 0.6f };
+	toRun.m_fadeDuration = 0.3f;
+	toRun.m_isPhaseMatched = true;
+
+	StateTransition toWalk = toRun;
+	toWalk.m_from = run;
+	toWalk.m_to = walk;
+	toWalk.m_condition = { ConditionType::Less, speed, 0.4f };
+
+	definition.addTransition(toRun);
+	definition.addTransition(toWalk);
+
+	/*Every character goes back and forth between the walk and the run at its own pace*/
+	std::vector<StateMachineInstance> instances(instanceCount);
+	std::vector<float> periods(instanceCount);
+
+	for (size_t i = 0; i < instanceCount; ++i)
+	{
+		instances[i].initialize(definition, float(i) * 0.013f);
+		periods[i] = 1.f + float(i % 97) * 0.05f;
+	}
+
+	float time = 0.f;
+
+	auto updateInstances = [&]()
+	{
+		time += frameTime;
+
+		for (size_t i = 0; i < instanceCount; ++i)
+		{
+			float progress = std::fmod(time / periods[i], 2.f);
+
+			instances[i].setParameter(speed, progress < 1.f ? progress : 2.f - progress);
+			instances[i].update(frameTime);
+		}
+	};
+
+	std::cout << "State machine (" << instanceCount << " characters, " << boneCount
+			  << " bones), one operation is a character" << std::endl;
+
+	BenchmarkResult update = measure([&]()
+	{
+		updateInstances();
+		g_benchmarkSink = instances[instanceCount - 1].m_time;
+	}, frameCount, instanceCount);
+
+	printBenchmarkResult("  update", update);
+
+	size_t fadingCount = 0;
+
+	for (StateMachineInstance const& instance : instances)
+	{
+		fadingCount += instance.isFading() ? 1 : 0;
+	}
+
+	std::vector<Transform> pose(boneCount);
+	std::vector<Transform> fadingPose(boneCount);
+
+	BenchmarkResult evaluate = measure([&]()
+	{
+		updateInstances();
+
+		for (StateMachineInstance const& instance : instances)
+		{
+			instance.evaluate(pose.data(), fadingPose.data());
+		}
+		g_benchmarkSink = pose[boneCount - 1].m_rotation.m_a;
+	}, frameCount, instanceCount);
+
+	printBenchmarkResult("  update and evaluate active states", evaluate);
+
+	/*Reference : both clips sampled and blended for every character whatever its state*/
+	BenchmarkResult sampleBoth = measure([&]()
+	{
+		updateInstances();
+
+		for (StateMachineInstance const& instance : instances)
+		{
+			walkClip.sampleTime(instance.m_time, pose.data());
+			runClip.sampleTime(instance.m_time, fadingPose.data());
+			blendPoses(pose.data(), fadingPose.data(), instance.weight(), boneCount, pose.data(),
+					   walkClip.m_rotationInterpolation);
+		}
+		g_benchmarkSink = pose[boneCount - 1].m_rotation.m_a;
+	}, frameCount, instanceCount);
+
+	printBenchmarkResult("  update and blend both clips", sampleBoth);
+	printBenchmarkSpeedup("    speedup of the active states", sampleBoth, evaluate);
+
+	std::cout << "    " << fadingCount << " of " << instanceCount << " characters cross-fading after the first run"
+			  << std::endl;
+}
@@ -0,0 +1,110 @@
+#pragma region Benchmark
+
+#include "Benchmark.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "../Skeleton.h"
+#include "../AnimationClip.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cmath>
+#include <vector>
+#include <iostream>
+
+#pragma endregion
+
+namespace
+{
+	/// Copy a clip back to one track per bone
+	AnimationClip		expandTracks(AnimationClip const& _clip)
+	{
+		AnimationClip result;
+		result.resize(_clip.m_boneCount, _clip.m_keyCount);
+		result.m_duration = _clip.m_duration;
+		result.m_rotationInterpolation = _clip.m_rotationInterpolation;
+
+		for (size_t j = 0; j < _clip.m_keyCount; ++j)
+		{
+			for (size_t i = 0; i < _clip.m_boneCount; ++i)
+			{
+				result.setKey(j, i, _clip.getKey(j, i));
+			}
+		}
+
+		return result;
+	}
+
+	/// Print the classification of a clip and compare its sampling cost with one track per bone
+	void				measureTrackSampling(const char* _name, AnimationClip const& _clip)
+	{
+		const size_t sampleCount = 256;
+		const size_t repeatCount = 64;
+
+		AnimationClip expanded = expandTracks(_clip);
+
+		std::vector<Transform> pose(_clip.m_boneCount);
+		std::vector<Transform> expandedPose(_clip.m_boneCount);
+
+		float difference = 0.f;
+
+		for (size_t i = 0; i < sampleCount; ++i)
+		{
+			float time = _clip.m_duration * float(i) / float(sampleCount);
+
+			_clip.sampleTime(time, pose.data());
+			expanded.sampleTime(time, expandedPose.data());
+
+			difference = std::fmax(difference, largestDifference(pose, expandedPose));
+		}
+
+		std::cout << _name << " : " << _clip.trackClassCount(TrackClass::Constant) << " constant, "
+				  << _clip.trackClassCount(TrackClass::RotationOnly) << " rotation only, "
+				  << _clip.trackClassCount(TrackClass::Animated) << " animated bones, "
+				  << expanded.footprint() << " -> " << _clip.footprint() << " bytes, largest difference "
+				  << difference << std::endl;
+
+		BenchmarkResult perBone = measure([&]()
+		{
+			for (size_t i = 0; i < sampleCount; ++i)
+			{
+				expanded.sampleTime(expanded.m_duration * float(i) / float(sampleCount), pose.data());
+			}
+			g_benchmarkSink = pose[1].m_rotation.m_a;
+		}, repeatCount, sampleCount);
+
+		BenchmarkResult classified = measure([&]()
+		{
+			for (size_t i = 0; i < sampleCount; ++i)
+			{
+				_clip.sampleTime(_clip.m_duration * float(i) / float(sampleCount), pose.data());
+			}
+			g_benchmarkSink = pose[1].m_rotation.m_a;
+		}, repeatCount, sampleCount);
+
+		printBenchmarkResult("  one track per bone sampleTime", perBone);
+		printBenchmarkResult("  classified sampleTime", classified);
+		printBenchmarkSpeedup("  speedup", perBone, classified);
+	}
+}
+
+/// Classify the tracks of the walk and run clips and compare the sampling cost with one track per bone
+void					runTrackBenchmark()
+{
+	Skeleton skeleton;
+	AnimationClip walkClip;
+	AnimationClip runClip;
+
+	if (!loadBenchmarkAssets(skeleton, walkClip, runClip))
+		return;
+
+	std::cout << "Track classification, one operation is a whole pose" << std::endl;
+
+	measureTrackSampling("ThirdPersonWalk.anim", walkClip);
+	measureTrackSampling("ThirdPersonRun.anim", runClip);
+}
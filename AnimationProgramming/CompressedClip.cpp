@@ -0,0 +1,411 @@
+#include "CompressedClip.h"
+
+#pragma region Standard
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+
+#pragma endregion
+
+namespace
+{
+	/// Largest value of the three smallest components of a unit quaternion
+	const float		g_smallestThreeRange = 0.70710678f;
+	/// Largest value stored on 15 bits
+	const float		g_rotationSteps = 32767.f;
+	/// Largest value stored on 16 bits
+	const float		g_translationSteps = 65535.f;
+	/// Size of a key in the .anim files : position, rotation and scale
+	const size_t	g_rawKeySize = 10 * sizeof(float);
+
+	/// Quantize a value of [_min, _min + _extent] on _steps
+	uint32_t		quantize(float _value, float _min, float _extent, float _steps)
+	{
+		if (_extent <= 0.f)
+			return 0;
+
+		float normalized = (_value - _min) / _extent;
+		normalized = normalized < 0.f ? 0.f : (normalized > 1.f ? 1.f : normalized);
+
+		return static_cast<uint32_t>(normalized * _steps + 0.5f);
+	}
+
+	/// Rebuild a value quantized on _steps
+	float			dequantize(uint32_t _value, float _min, float _extent, float _steps)
+	{
+		return _min + float(_value) / _steps * _extent;
+	}
+
+	/// Decode the translation of a bone
+	LibMath::Vector3	unpackTranslation(PackedVector3 const& _packed, LibMath::Vector3 const& _min, 
+										  LibMath::Vector3 const& _extent)
+	{
+		return LibMath::Vector3(dequantize(_packed.m_bits[0], _min.m_x, _extent.m_x, g_translationSteps),
+								dequantize(_packed.m_bits[1], _min.m_y, _extent.m_y, g_translationSteps),
+								dequantize(_packed.m_bits[2], _min.m_z, _extent.m_z, g_translationSteps));
+	}
+
+	/// Angle between two rotations in degrees
+	float			angleBetween(LibMath::Quaternion const& _lhs, LibMath::Quaternion const& _rhs)
+	{
+		/*acos is ill-conditioned near 1, in float it alone would report errors of a few hundredths of a degree*/
+		double lhs[4] = { _lhs.m_a, _lhs.m_b, _lhs.m_c, _lhs.m_d };
+		double rhs[4] = { _rhs.m_a, _rhs.m_b, _rhs.m_c, _rhs.m_d };
+
+		double dot = 0.0;
+		double lhsLength = 0.0;
+		double rhsLength = 0.0;
+
+		for (int i = 0; i < 4; ++i)
+		{
+			dot += lhs[i] * rhs[i];
+			lhsLength += lhs[i] * lhs[i];
+			rhsLength += rhs[i] * rhs[i];
+		}
+
+		dot = std::fabs(dot) / std::sqrt(lhsLength * rhsLength);
+		dot = dot > 1.0 ? 1.0 : dot;
+
+		return float(2.0 * std::acos(dot) * 57.29577951308232);
+	}
+
+	/// Length of the difference of two vectors
+	float			distance(LibMath::Vector3 const& _lhs, LibMath::Vector3 const& _rhs)
+	{
+		float x = _lhs.m_x - _rhs.m_x;
+		float y = _lhs.m_y - _rhs.m_y;
+		float z = _lhs.m_z - _rhs.m_z;
+
+		return std::sqrt(x * x + y * y + z * z);
+	}
+}
+
+/// Pack a unit quaternion in 48 bits, the largest component is rebuilt from the three others
+PackedQuaternion		packQuaternion(LibMath::Quaternion const& _rotation)
+{
+	float components[4] = { _rotation.m_a, _rotation.m_b, _rotation.m_c, _rotation.m_d };
+
+	uint32_t largest = 0;
+
+	for (uint32_t i = 1; i < 4; ++i)
+	{
+		if (std::fabs(components[i]) > std::fabs(components[largest]))
+			largest = i;
+	}
+
+	/*q and -q are the same rotation, keep the largest component positive so its sign is not stored*/
+	float sign = components[largest] < 0.f ? -1.f : 1.f;
+
+	uint64_t bits = largest;
+
+	for (uint32_t i = 0, shift = 2; i < 4; ++i)
+	{
+		if (i == largest)
+			continue;
+
+		uint64_t value = quantize(components[i] * sign, -g_smallestThreeRange, 2.f * g_smallestThreeRange, 
+								  g_rotationSteps);
+		bits |= value << shift;
+		shift += 15;
+	}
+
+	PackedQuaternion packed;
+	packed.m_bits[0] = static_cast<uint16_t>(bits);
+	packed.m_bits[1] = static_cast<uint16_t>(bits >> 16);
+	packed.m_bits[2] = static_cast<uint16_t>(bits >> 32);
+
+	return packed;
+}
+
+/// Unpack a quaternion packed by packQuaternion
+LibMath::Quaternion		unpackQuaternion(PackedQuaternion const& _packed)
+{
+	uint64_t bits = uint64_t(_packed.m_bits[0]) | (uint64_t(_packed.m_bits[1]) << 16) | 
+					(uint64_t(_packed.m_bits[2]) << 32);
+
+	uint32_t largest = static_cast<uint32_t>(bits & 3);
+
+	float components[4];
+	float squaredSum = 0.f;
+
+	for (uint32_t i = 0, shift = 2; i < 4; ++i)
+	{
+		if (i == largest)
+			continue;
+
+		components[i] = dequantize(static_cast<uint32_t>((bits >> shift) & 0x7FFF), -g_smallestThreeRange, 
+								   2.f * g_smallestThreeRange, g_rotationSteps);
+		squaredSum += components[i] * components[i];
+		shift += 15;
+	}
+
+	components[largest] = std::sqrt(squaredSum < 1.f ? 1.f - squaredSum : 0.f);
+
+	return LibMath::Quaternion(components[0], components[1], components[2], components[3]);
+}
+
+/// Copy the constant pose of a clip and quantize every key of its tracks
+void				CompressedClip::compress(AnimationClip const& _clip)
+{
+	m_boneCount = _clip.m_boneCount;
+	m_keyCount = _clip.m_keyCount;
+	m_duration = _clip.m_duration;
+	m_rotationInterpolation = _clip.m_rotationInterpolation;
+
+	/*The constant channels are already stored once, they are not quantized*/
+	m_constantPose = _clip.m_constantPose;
+	m_rotationBones = _clip.m_rotationBones;
+	m_translationBones = _clip.m_translationBones;
+
+	size_t rotationTrackCount = m_rotationBones.size();
+	size_t translationTrackCount = m_translationBones.size();
+
+	m_rotations.resize(rotationTrackCount * m_keyCount);
+	m_translations.resize(translationTrackCount * m_keyCount);
+
+	m_translationMins.assign(translationTrackCount, LibMath::Vector3(0.f, 0.f, 0.f));
+	m_translationExtents.assign(translationTrackCount, LibMath::Vector3(0.f, 0.f, 0.f));
+	m_scaleTracks.assign(translationTrackCount, -1);
+	m_scaleTrackCount = 0;
+
+	for (size_t track = 0; track < translationTrackCount && m_keyCount > 0; ++track)
+	{
+		uint32_t bone = m_translationBones[track];
+
+		/*Range of the translation track*/
+		LibMath::Vector3 min = _clip.translation(0, bone);
+		LibMath::Vector3 max = min;
+
+		/*The scale track is dropped when every key has the scale of the first one*/
+		LibMath::Vector3 firstScale = _clip.scale(0, bone);
+		bool isScaleConstant = true;
+
+		for (size_t j = 1; j < m_keyCount; ++j)
+		{
+			LibMath::Vector3 translation = _clip.translation(j, bone);
+			LibMath::Vector3 scale = _clip.scale(j, bone);
+
+			min = LibMath::Vector3(std::fmin(min.m_x, translation.m_x), std::fmin(min.m_y, translation.m_y), 
+								   std::fmin(min.m_z, translation.m_z));
+			max = LibMath::Vector3(std::fmax(max.m_x, translation.m_x), std::fmax(max.m_y, translation.m_y), 
+								   std::fmax(max.m_z, translation.m_z));
+
+			isScaleConstant = isScaleConstant && scale.m_x == firstScale.m_x && scale.m_y == firstScale.m_y && 
+							  scale.m_z == firstScale.m_z;
+		}
+
+		m_translationMins[track] = min;
+		m_translationExtents[track] = LibMath::Vector3(max.m_x - min.m_x, max.m_y - min.m_y, max.m_z - min.m_z);
+		m_constantPose[bone].m_scale = firstScale;
+
+		if (!isScaleConstant)
+			m_scaleTracks[track] = static_cast<int>(m_scaleTrackCount++);
+	}
+
+	m_scales.resize(m_scaleTrackCount * m_keyCount);
+
+	for (size_t j = 0; j < m_keyCount; ++j)
+	{
+		for (size_t track = 0; track < rotationTrackCount; ++track)
+		{
+			LibMath::Quaternion rotation = LibMath::normalize(_clip.rotation(j, m_rotationBones[track]));
+
+			m_rotations[j * rotationTrackCount + track] = packQuaternion(rotation);
+		}
+
+		for (size_t track = 0; track < translationTrackCount; ++track)
+		{
+			uint32_t bone = m_translationBones[track];
+
+			LibMath::Vector3 translation = _clip.translation(j, bone);
+			LibMath::Vector3 const& min = m_translationMins[track];
+			LibMath::Vector3 const& extent = m_translationExtents[track];
+
+			PackedVector3& packed = m_translations[j * translationTrackCount + track];
+
+			packed.m_bits[0] = static_cast<uint16_t>(quantize(translation.m_x, min.m_x, extent.m_x, g_translationSteps));
+			packed.m_bits[1] = static_cast<uint16_t>(quantize(translation.m_y, min.m_y, extent.m_y, g_translationSteps));
+			packed.m_bits[2] = static_cast<uint16_t>(quantize(translation.m_z, min.m_z, extent.m_z, g_translationSteps));
+
+			if (m_scaleTracks[track] != -1)
+				m_scales[j * m_scaleTrackCount + m_scaleTracks[track]] = _clip.scale(j, bone);
+		}
+	}
+}
+
+/// Decode every bone of a key into a pose
+void				CompressedClip::sampleKey(size_t _key, Transform* _pose) const
+{
+	size_t rotationTrackCount = m_rotationBones.size();
+	size_t translationTrackCount = m_translationBones.size();
+
+	const PackedQuaternion*	rotations		= m_rotations.data() + _key * rotationTrackCount;
+	const PackedVector3*	translations	= m_translations.data() + _key * translationTrackCount;
+
+	/*The constant channels are copied as they are, the tracks overwrite the others*/
+	std::copy(m_constantPose.begin(), m_constantPose.end(), _pose);
+
+	for (size_t track = 0; track < translationTrackCount; ++track)
+	{
+		Transform& transform = _pose[m_translationBones[track]];
+
+		transform.m_position = unpackTranslation(translations[track], m_translationMins[track], m_translationExtents[track]);
+
+		if (m_scaleTracks[track] != -1)
+			transform.m_scale = m_scales[_key * m_scaleTrackCount + m_scaleTracks[track]];
+	}
+
+	for (size_t track = 0; track < rotationTrackCount; ++track)
+	{
+		_pose[m_rotationBones[track]].m_rotation = unpackQuaternion(rotations[track]);
+	}
+}
+
+/// Decode and interpolate every bone between two keys into a pose
+void				CompressedClip::samplePose(size_t _key, size_t _nextKey, float _t, Transform* _pose) const
+{
+	size_t rotationTrackCount = m_rotationBones.size();
+	size_t translationTrackCount = m_translationBones.size();
+
+	const PackedQuaternion*	rotations			= m_rotations.data() + _key * rotationTrackCount;
+	const PackedVector3*	translations		= m_translations.data() + _key * translationTrackCount;
+
+	const PackedQuaternion*	nextRotations		= m_rotations.data() + _nextKey * rotationTrackCount;
+	const PackedVector3*	nextTranslations	= m_translations.data() + _nextKey * translationTrackCount;
+
+	/*Constant channels skip the decoding and the interpolation*/
+	std::copy(m_constantPose.begin(), m_constantPose.end(), _pose);
+
+	for (size_t track = 0; track < translationTrackCount; ++track)
+	{
+		LibMath::Vector3 const& min = m_translationMins[track];
+		LibMath::Vector3 const& extent = m_translationExtents[track];
+
+		Transform& transform = _pose[m_translationBones[track]];
+
+		transform.m_position = LibMath::Vector3::lerpPosition(unpackTranslation(translations[track], min, extent),
+															  unpackTranslation(nextTranslations[track], min, extent), _t);
+
+		if (m_scaleTracks[track] != -1)
+		{
+			transform.m_scale = LibMath::Vector3::lerpScale(m_scales[_key * m_scaleTrackCount + m_scaleTracks[track]],
+															m_scales[_nextKey * m_scaleTrackCount + m_scaleTracks[track]], _t);
+		}
+	}
+
+	for (size_t track = 0; track < rotationTrackCount; ++track)
+	{
+		_pose[m_rotationBones[track]].m_rotation = LibMath::interpolateRotation(unpackQuaternion(rotations[track]),
+																				unpackQuaternion(nextRotations[track]),
+																				_t, m_rotationInterpolation);
+	}
+}
+
+/// Decode and interpolate every bone at a time in seconds, clamped to the clip
+void				CompressedClip::sampleTime(float _time, Transform* _pose) const
+{
+	KeyPosition position = findKeyPosition(_time, m_duration, m_keyCount);
+
+	if (position.m_key == position.m_nextKey)
+	{
+		sampleKey(position.m_key, _pose);
+	}
+	else
+	{
+		samplePose(position.m_key, position.m_nextKey, position.m_t, _pose);
+	}
+}
+
+/// Memory used by the compressed keys, the track ranges, the constant pose and the track tables in bytes
+size_t				CompressedClip::footprint() const
+{
+	return m_rotations.size() * sizeof(PackedQuaternion) +
+		   m_translations.size() * sizeof(PackedVector3) +
+		   m_translationMins.size() * sizeof(LibMath::Vector3) +
+		   m_translationExtents.size() * sizeof(LibMath::Vector3) +
+		   m_scaleTracks.size() * sizeof(int) +
+		   m_scales.size() * sizeof(LibMath::Vector3) +
+		   m_constantPose.size() * sizeof(Transform) +
+		   (m_rotationBones.size() + m_translationBones.size()) * sizeof(uint32_t);
+}
+
+/// Compare every key of a compressed clip with the keys of the raw file loaded without classifyTracks, one error per bone
+std::vector<CompressionError>	measureCompressionError(AnimationClip const& _rawClip, CompressedClip const& _compressed,
+														Skeleton const& _skeleton)
+{
+	size_t boneCount = _rawClip.m_boneCount;
+
+	std::vector<CompressionError> errors(boneCount);
+
+	std::vector<Transform> rawPose(boneCount);
+	std::vector<Transform> decodedPose(boneCount);
+	std::vector<Transform> rawWorldPose(boneCount);
+	std::vector<Transform> decodedWorldPose(boneCount);
+
+	for (size_t j = 0; j < _rawClip.m_keyCount; ++j)
+	{
+		_rawClip.sampleKey(j, rawPose.data());
+		_compressed.sampleKey(j, decodedPose.data());
+
+		_skeleton.computeWorldPose(rawPose.data(), rawWorldPose.data());
+		_skeleton.computeWorldPose(decodedPose.data(), decodedWorldPose.data());
+
+		for (size_t i = 0; i < boneCount; ++i)
+		{
+			CompressionError& error = errors[i];
+
+			error.m_rotation = std::fmax(error.m_rotation, angleBetween(rawPose[i].m_rotation, decodedPose[i].m_rotation));
+			error.m_translation = std::fmax(error.m_translation, distance(rawPose[i].m_position, 
+																		  decodedPose[i].m_position));
+			error.m_objectPosition = std::fmax(error.m_objectPosition, distance(rawWorldPose[i].m_position, 
+																				decodedWorldPose[i].m_position));
+		}
+	}
+
+	return errors;
+}
+
+/// Print the compression ratio against the raw file and the classified clip it was compressed from and the largest
+/// error of every bone against the raw file
+void				printCompressionReport(const char* _name, AnimationClip const& _rawClip, AnimationClip const& _clip,
+										   CompressedClip const& _compressed, Skeleton const& _skeleton)
+{
+	size_t rawSize = _rawClip.m_boneCount * _rawClip.m_keyCount * g_rawKeySize;
+	size_t compressedSize = _compressed.footprint();
+
+	std::vector<CompressionError> errors = measureCompressionError(_rawClip, _compressed, _skeleton);
+
+	CompressionError largest;
+
+	for (CompressionError const& error : errors)
+	{
+		largest.m_rotation = std::fmax(largest.m_rotation, error.m_rotation);
+		largest.m_translation = std::fmax(largest.m_translation, error.m_translation);
+		largest.m_objectPosition = std::fmax(largest.m_objectPosition, error.m_objectPosition);
+	}
+
+	std::cout << _name << " : " << rawSize << " bytes raw, " << _clip.footprint() << " bytes classified, " 
+			  << compressedSize << " bytes compressed, ratio " << std::fixed << std::setprecision(2) 
+			  << double(rawSize) / double(compressedSize) << " x against the raw file and "
+			  << double(_clip.footprint()) / double(compressedSize) << " x against the classified clip, "
+			  << _compressed.m_scaleTrackCount << " scale tracks kept" << std::endl;
+
+	std::cout << std::setw(6) << "bone" << std::setw(14) << "rotation deg" << std::setw(14) << "translation" 
+			  << std::setw(14) << "object pos" << std::endl;
+
+	std::cout << std::setprecision(5);
+
+	for (size_t i = 0; i < errors.size(); ++i)
+	{
+		std::cout << std::setw(6) << i << std::setw(14) << errors[i].m_rotation << std::setw(14) 
+				  << errors[i].m_translation << std::setw(14) << errors[i].m_objectPosition << std::endl;
+	}
+
+	std::cout << std::setw(6) << "max" << std::setw(14) << largest.m_rotation << std::setw(14) 
+			  << largest.m_translation << std::setw(14) << largest.m_objectPosition << std::endl;
+
+	std::cout.unsetf(std::ios_base::fixed);
+	std::cout << std::setprecision(6);
+}
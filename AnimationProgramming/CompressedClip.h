@@ -0,0 +1,93 @@
+#pragma once
+
+#pragma region Animation
+
+#include "Transform.h"
+#include "AnimationClip.h"
+#include "Skeleton.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstdint>
+#include <vector>
+
+#pragma endregion
+
+/// Rotation stored with the smallest three components on 15 bits and the index of the largest one on 2 bits
+struct PackedQuaternion
+{
+	uint16_t				m_bits[3];
+};
+
+/// Translation stored on 16 bits per component inside the range of its track
+struct PackedVector3
+{
+	uint16_t				m_bits[3];
+};
+
+/// Quantize
+// Pack a unit quaternion in 48 bits, the largest component is rebuilt from the three others
+PackedQuaternion		packQuaternion(LibMath::Quaternion const& _rotation);
+// Unpack a quaternion packed by packQuaternion
+LibMath::Quaternion		unpackQuaternion(PackedQuaternion const& _packed);
+
+/// Quantized copy of the animated tracks of a classified AnimationClip, keys stored key-major like the clip. The
+/// constant channels stay in the constant pose of the clip
+struct CompressedClip
+{
+	std::vector<PackedQuaternion>	m_rotations; // Rotation of every rotation track for every key
+	std::vector<PackedVector3>		m_translations; // Translation of every translation track for every key
+
+	std::vector<LibMath::Vector3>	m_translationMins; // Smallest translation of every translation track
+	std::vector<LibMath::Vector3>	m_translationExtents; // Range of the translation of every translation track
+
+	std::vector<int>				m_scaleTracks; // Scale track of every translation track, -1 if the scale is constant
+	std::vector<LibMath::Vector3>	m_scales; // Scale of every animated scale track for every key
+
+	std::vector<Transform>			m_constantPose; // Channels stored once, the sampler starts from this pose
+	std::vector<uint32_t>			m_rotationBones; // Bone of every rotation track
+	std::vector<uint32_t>			m_translationBones; // Bone of every translation track
+
+	size_t							m_boneCount = 0; // Number of bones per key
+	size_t							m_keyCount = 0; // Number of keys
+	size_t							m_scaleTrackCount = 0; // Number of translation tracks with an animated scale
+
+	float							m_duration = 0.f; // Duration in seconds
+
+	LibMath::RotationInterpolation	m_rotationInterpolation = LibMath::RotationInterpolation::Slerp; // Copied from the source clip
+
+	/// Compress
+	// Copy the constant pose of a clip and quantize every key of its tracks
+	void					compress(AnimationClip const& _clip);
+
+	/// Sample
+	// Decode every bone of a key into a pose
+	void					sampleKey(size_t _key, Transform* _pose) const;
+	// Decode and interpolate every bone between two keys into a pose
+	void					samplePose(size_t _key, size_t _nextKey, float _t, Transform* _pose) const;
+	// Decode and interpolate every bone at a time in seconds, clamped to the clip
+	void					sampleTime(float _time, Transform* _pose) const;
+
+	/// Memory
+	// Memory used by the compressed keys, the track ranges, the constant pose and the track tables in bytes
+	size_t					footprint() const;
+};
+
+/// Error of a compressed bone against the raw keys
+struct CompressionError
+{
+	float					m_rotation = 0.f; // Largest local rotation error in degrees
+	float					m_translation = 0.f; // Largest local translation error
+	float					m_objectPosition = 0.f; // Largest position error in object space after the hierarchy
+};
+
+/// Report
+// Compare every key of a compressed clip with the keys of the raw file loaded without classifyTracks, one error per bone
+std::vector<CompressionError>	measureCompressionError(AnimationClip const& _rawClip, CompressedClip const& _compressed,
+														Skeleton const& _skeleton);
+// Print the compression ratio against the raw file and the classified clip it was compressed from and the largest
+// error of every bone against the raw file
+void					printCompressionReport(const char* _name, AnimationClip const& _rawClip, AnimationClip const& _clip,
+											   CompressedClip const& _compressed, Skeleton const& _skeleton);
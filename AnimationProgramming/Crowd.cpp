@@ -0,0 +1,89 @@
+#include "Crowd.h"
+
+/// Create _instanceCount characters playing the clips in turn with spread start times, reading the poses baked in _poseCache
+void				Crowd::initialize(Skeleton const& _skeleton, std::vector<const AnimationClip*> const& _clips, 
+									  size_t _instanceCount, PaletteFormat _paletteFormat, 
+									  const WorldPoseCache* _poseCache)
+{
+	m_instances.resize(_instanceCount);
+
+	for (size_t i = 0; i < _instanceCount; ++i)
+	{
+		AnimationClip const& clip = *_clips[i % _clips.size()];
+
+		/*Spread the start times so the characters are not synchronized*/
+		float startTime = clip.m_duration * float(i % 17) / 17.f;
+
+		m_instances[i].initialize(_skeleton, clip, startTime, _paletteFormat);
+		m_instances[i].m_poseCache = _poseCache;
+	}
+}
+
+/// Advance and evaluate every instance on the pool, one palette per instance
+void				Crowd::update(float _frameTime, ThreadPool& _pool)
+{
+	_pool.parallelFor(m_instances.size(), m_grainSize, [this, _frameTime](size_t _begin, size_t _end)
+	{
+		for (size_t i = _begin; i < _end; ++i)
+		{
+			m_instances[i].advance(_frameTime);
+			m_instances[i].evaluate();
+		}
+	});
+}
+
+/// Advance and evaluate every instance on the calling thread
+void				Crowd::update(float _frameTime)
+{
+	for (AnimationInstance& instance : m_instances)
+	{
+		instance.advance(_frameTime);
+		instance.evaluate();
+	}
+}
+
+/// Add a pose and a palette task per group of m_grainSize instances to _graph, the pose task also advances the time
+void				Crowd::addFrameTasks(TaskGraph& _graph, std::vector<size_t>& _poseTasks, 
+										 std::vector<size_t>& _paletteTasks)
+{
+	size_t grainSize = m_grainSize > 0 ? m_grainSize : 1;
+
+	_poseTasks.clear();
+	_paletteTasks.clear();
+
+	for (size_t begin = 0; begin < m_instances.size(); begin += grainSize)
+	{
+		size_t end = begin + grainSize < m_instances.size() ? begin + grainSize : m_instances.size();
+
+		size_t poseTask = _graph.addTask([this, begin, end]()
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				m_instances[i].advance(m_frameTime);
+				m_instances[i].evaluatePose();
+			}
+		});
+
+		/*The palettes of a group are built while the other groups are still sampled*/
+		size_t paletteTask = _graph.addTask([this, begin, end]()
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				m_instances[i].buildPalette();
+			}
+		});
+
+		_graph.addDependency(poseTask, paletteTask);
+
+		_poseTasks.push_back(poseTask);
+		_paletteTasks.push_back(paletteTask);
+	}
+}
+
+/// Advance and evaluate every instance by running a graph built with addFrameTasks
+void				Crowd::update(float _frameTime, TaskGraph& _graph, ThreadPool& _pool)
+{
+	m_frameTime = _frameTime;
+
+	_graph.run(_pool);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#pragma region Animation
+
+#include "AnimationInstance.h"
+#include "ThreadPool.h"
+#include "TaskGraph.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <vector>
+
+#pragma endregion
+
+/// Characters sharing clips and a skeleton, updated in parallel
+struct Crowd
+{
+	std::vector<AnimationInstance>	m_instances;
+
+	size_t							m_grainSize = 8; // Instances evaluated by one task
+
+	float							m_frameTime = 0.f; // Time advanced by the tasks added with addFrameTasks
+
+	/// Initialize
+	// Create _instanceCount characters playing the clips in turn with spread start times, reading the poses baked in _poseCache
+	void					initialize(Skeleton const& _skeleton, std::vector<const AnimationClip*> const& _clips, 
+									   size_t _instanceCount, PaletteFormat _paletteFormat = PaletteFormat::Matrix4,
+									   const WorldPoseCache* _poseCache = nullptr);
+
+	/// Update
+	// Advance and evaluate every instance on the pool, one palette per instance
+	void					update(float _frameTime, ThreadPool& _pool);
+	// Advance and evaluate every instance on the calling thread
+	void					update(float _frameTime);
+
+	/// Task graph
+	// Add a pose and a palette task per group of m_grainSize instances to _graph, the pose task also advances the time
+	void					addFrameTasks(TaskGraph& _graph, std::vector<size_t>& _poseTasks, 
+										  std::vector<size_t>& _paletteTasks);
+	// Advance and evaluate every instance by running a graph built with addFrameTasks
+	void					update(float _frameTime, TaskGraph& _graph, ThreadPool& _pool);
+	// Index of the group of an instance in the tasks of addFrameTasks
+	size_t					taskGroup(size_t _instance) const { return _instance / (m_grainSize > 0 ? m_grainSize : 1); }
+};
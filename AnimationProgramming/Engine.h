@@ -1,7 +1,16 @@
 #ifndef __ENGINE_H__
 #define __ENGINE_H__
 
-#ifdef ENGINE_EXPORTS
+#include <cstddef>
+
+// Engine.dll only exists on Windows, elsewhere the headless implementation in Headless/ is linked instead
+#if !defined(_WIN32) && !defined(HEADLESS_ENGINE)
+#define HEADLESS_ENGINE
+#endif
+
+#if defined(HEADLESS_ENGINE)
+#define ENGINE_API
+#elif defined(ENGINE_EXPORTS)
 #define ENGINE_API __declspec(dllexport) 
 #else
 #define ENGINE_API __declspec(dllimport) 
@@ -0,0 +1,63 @@
+#include "FrameArena.h"
+
+#pragma region Standard
+
+#include <cstdint>
+
+#pragma endregion
+
+/// Reserve _capacity bytes, the arena grows to the peak of the frames that do not fit
+FrameArena::FrameArena(size_t _capacity) :
+	m_buffer(_capacity > 0 ? new unsigned char[_capacity] : nullptr), m_capacity(_capacity)
+{
+}
+
+/// Release every allocation, the buffer is grown to hold a whole frame if the last one overflowed
+void				FrameArena::reset()
+{
+	if (!m_overflowBlocks.empty())
+	{
+		/*The overflow blocks are padded for their alignment so the new buffer holds the same frame*/
+		size_t capacity = m_offset + m_overflowSize;
+
+		m_overflowBlocks.clear();
+		m_buffer.reset(new unsigned char[capacity]);
+		m_capacity = capacity;
+	}
+
+	m_offset = 0;
+	m_overflowSize = 0;
+}
+
+/// Allocate _size bytes aligned on _alignment, valid until the next reset
+void*				FrameArena::allocate(size_t _size, size_t _alignment)
+{
+	if (m_buffer)
+	{
+		uintptr_t address = reinterpret_cast<uintptr_t>(m_buffer.get()) + m_offset;
+		size_t padding = (_alignment - address % _alignment) % _alignment;
+
+		if (m_offset + padding + _size <= m_capacity)
+		{
+			void* memory = m_buffer.get() + m_offset + padding;
+			m_offset += padding + _size;
+
+			return memory;
+		}
+	}
+
+	return allocateOverflow(_size, _alignment);
+}
+
+/// Allocate a block on the heap when the buffer is full
+void*				FrameArena::allocateOverflow(size_t _size, size_t _alignment)
+{
+	size_t blockSize = _size + _alignment;
+
+	m_overflowBlocks.emplace_back(new unsigned char[blockSize]);
+	m_overflowSize += blockSize;
+
+	uintptr_t address = reinterpret_cast<uintptr_t>(m_overflowBlocks.back().get());
+
+	return m_overflowBlocks.back().get() + (_alignment - address % _alignment) % _alignment;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#pragma region Standard
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#pragma endregion
+
+/// Linear allocator for the temporaries of one frame, everything is released at once by reset
+class FrameArena
+{
+	/// Variables
+	std::unique_ptr<unsigned char[]>				m_buffer;
+	size_t											m_capacity = 0; // Bytes of the buffer
+	size_t											m_offset = 0; // Bytes of the buffer used since the last reset
+
+	std::vector<std::unique_ptr<unsigned char[]>>	m_overflowBlocks; // Allocated when the buffer was full, merged by reset
+	size_t											m_overflowSize = 0; // Bytes of the overflow blocks
+
+	/// Allocate
+	// Allocate a block on the heap when the buffer is full
+	void*					allocateOverflow(size_t _size, size_t _alignment);
+
+public:
+
+	/// Constructor
+	// Reserve _capacity bytes, the arena grows to the peak of the frames that do not fit
+	explicit				FrameArena(size_t _capacity = 0);
+							FrameArena(FrameArena const&) = delete;
+	FrameArena&				operator=(FrameArena const&) = delete;
+
+	/// Frame
+	// Release every allocation, the buffer is grown to hold a whole frame if the last one overflowed
+	void					reset();
+
+	/// Allocate
+	// Allocate _size bytes aligned on _alignment, valid until the next reset
+	void*					allocate(size_t _size, size_t _alignment = alignof(std::max_align_t));
+	// Allocate and default construct _count objects, they are never destroyed
+	template <typename T>
+	T*						allocate(size_t _count)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "The arena never calls the destructors");
+
+		T* objects = static_cast<T*>(allocate(_count * sizeof(T), alignof(T)));
+
+		for (size_t i = 0; i < _count; ++i)
+		{
+			new (objects + i) T();
+		}
+
+		return objects;
+	}
+
+	/// Getter
+	size_t					capacity() const { return m_capacity; }
+	// Bytes allocated since the last reset, overflow included
+	size_t					used() const { return m_offset + m_overflowSize; }
+};
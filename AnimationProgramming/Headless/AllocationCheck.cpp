@@ -0,0 +1,135 @@
+#pragma region Headless
+
+#include "AllocationCheck.h"
+#include "HeadlessEngine.h"
+
+#pragma endregion
+
+#ifdef HEADLESS_ENGINE
+
+#pragma region Simulation
+
+#include "../MySimulation.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#pragma endregion
+
+namespace
+{
+	/// Allocations counted since beginAllocationCount, by every thread
+	std::atomic<size_t>		g_allocationCount(0);
+	std::atomic<bool>		g_isCountingAllocations(false);
+
+	/// Allocate through malloc and count the allocation while counting is on
+	void*					countedAllocate(size_t _size)
+	{
+		if (g_isCountingAllocations.load(std::memory_order_relaxed))
+		{
+			g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void* memory = std::malloc(_size > 0 ? _size : 1);
+
+		if (memory == nullptr)
+			throw std::bad_alloc();
+
+		return memory;
+	}
+}
+
+#pragma region Global allocation
+
+/*The headless build replaces the global operator new so the check sees every allocation, the engine build keeps the default one*/
+void*					operator new(size_t _size) { return countedAllocate(_size); }
+void*					operator new[](size_t _size) { return countedAllocate(_size); }
+void					operator delete(void* _memory) noexcept { std::free(_memory); }
+void					operator delete[](void* _memory) noexcept { std::free(_memory); }
+void					operator delete(void* _memory, size_t) noexcept { std::free(_memory); }
+void					operator delete[](void* _memory, size_t) noexcept { std::free(_memory); }
+
+#pragma endregion
+
+/// Start counting the allocations of every thread through the global operator new
+void					beginAllocationCount()
+{
+	g_allocationCount = 0;
+	g_isCountingAllocations = true;
+}
+
+/// Stop counting and return the allocations since beginAllocationCount
+size_t					endAllocationCount()
+{
+	g_isCountingAllocations = false;
+
+	return g_allocationCount;
+}
+
+/// Update every step past a warm up and count the allocations of each update, return false if a steady state frame allocates
+bool					runAllocationCheck(const char* _resourceDirectory, size_t _frameCount, size_t _warmUpFrameCount,
+										   float _frameTime)
+{
+	if (!initHeadlessEngine(_resourceDirectory) || _frameCount == 0)
+		return false;
+
+	std::cout << "Allocations of " << _frameCount << " frames at " << _frameTime << " s after " << _warmUpFrameCount 
+			  << " warm up frames" << std::endl;
+
+	const int stepCount = 7;
+	bool isValid = true;
+
+	for (int step = 1; step <= stepCount; ++step)
+	{
+		MySimulation simulation;
+		simulation.selectStep(step);
+		simulation.setResourceDirectory(_resourceDirectory);
+
+		ISimulation& checked = simulation;
+
+		/*Keep the bone hierarchy printed by init out of the report*/
+		std::streambuf* output = std::cout.rdbuf(nullptr);
+		checked.init();
+		std::cout.rdbuf(output);
+		std::cout.clear();
+
+		/*The first frames size the poses, the palettes and the crowd*/
+		for (size_t i = 0; i < _warmUpFrameCount; ++i)
+		{
+			beginHeadlessFrame();
+			checked.update(_frameTime);
+		}
+
+		size_t allocationCount = 0;
+		size_t allocatingFrameCount = 0;
+
+		for (size_t i = 0; i < _frameCount; ++i)
+		{
+			beginHeadlessFrame();
+
+			beginAllocationCount();
+			checked.update(_frameTime);
+			size_t frameAllocationCount = endAllocationCount();
+
+			allocationCount += frameAllocationCount;
+			allocatingFrameCount += frameAllocationCount > 0 ? 1 : 0;
+		}
+
+		bool isStepValid = allocationCount == 0;
+		isValid = isValid && isStepValid;
+
+		std::cout << "  step" << step << " : " << allocationCount << " allocations in " << allocatingFrameCount 
+				  << " frames " << (isStepValid ? "ok" : "FAILED") << std::endl;
+	}
+
+	return isValid;
+}
+
+#endif // HEADLESS_ENGINE
@@ -0,0 +1,19 @@
+#pragma once
+
+#pragma region Standard
+
+#include <cstddef>
+
+#pragma endregion
+
+/// Counting
+// Start counting the allocations of every thread through the global operator new
+void					beginAllocationCount();
+// Stop counting and return the allocations since beginAllocationCount
+size_t					endAllocationCount();
+
+/// Check
+// Update every step past a warm up and count the allocations of each update,
+// return false if the resources cannot be read or if a steady state frame allocates
+bool					runAllocationCheck(const char* _resourceDirectory, size_t _frameCount, size_t _warmUpFrameCount,
+										   float _frameTime);
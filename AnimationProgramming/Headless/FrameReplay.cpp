@@ -0,0 +1,150 @@
+#pragma region Headless
+
+#include "FrameReplay.h"
+#include "HeadlessEngine.h"
+
+#pragma endregion
+
+#ifdef HEADLESS_ENGINE
+
+#pragma region Simulation
+
+#include "../MySimulation.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#pragma endregion
+
+namespace
+{
+	/// Nearest rank percentile of sorted values
+	double				percentile(std::vector<double> const& _sortedValues, double _percent)
+	{
+		size_t rank = static_cast<size_t>(_percent / 100.0 * double(_sortedValues.size()) + 0.5);
+
+		rank = std::max<size_t>(rank, 1);
+		rank = std::min(rank, _sortedValues.size());
+
+		return _sortedValues[rank - 1];
+	}
+}
+
+/// Update an initialized simulation _frameCount times at a fixed frame time and measure every frame
+FrameReplayResult		replayFrames(ISimulation& _simulation, size_t _frameCount, float _frameTime)
+{
+	std::vector<double> frameTimes(_frameCount);
+
+	for (size_t i = 0; i < _frameCount; ++i)
+	{
+		beginHeadlessFrame();
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		_simulation.update(_frameTime);
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		frameTimes[i] = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / 1e3;
+	}
+
+	return computeFrameStatistics(frameTimes);
+}
+
+/// Replay every step of MySimulation on the headless engine, return false if the resources cannot be read
+bool					runFrameReplay(const char* _resourceDirectory, size_t _frameCount, float _frameTime)
+{
+	if (!initHeadlessEngine(_resourceDirectory) || _frameCount == 0)
+		return false;
+
+	std::cout << "Replay of " << _frameCount << " frames at " << _frameTime << " s, frame time in us" << std::endl;
+	std::cout << std::left << std::setw(12) << "" << std::right 
+			  << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90" 
+			  << std::setw(10) << "p99" << std::setw(10) << "max" << std::endl;
+
+	const char* names[] = { "step1", "step2", "step3", "step4", "step5", "step6", "step7" };
+	const int stepCount = sizeof(names) / sizeof(names[0]);
+	double updatedBoneCounts[stepCount] = {};
+
+	for (int step = 1; step <= stepCount; ++step)
+	{
+		MySimulation simulation;
+		simulation.selectStep(step);
+		simulation.setResourceDirectory(_resourceDirectory);
+
+		ISimulation& replayed = simulation;
+
+		/*Keep the bone hierarchy printed by init out of the report*/
+		std::streambuf* output = std::cout.rdbuf(nullptr);
+		replayed.init();
+		std::cout.rdbuf(output);
+		std::cout.clear();
+
+		printFrameReplayResult(names[step - 1], replayFrames(replayed, _frameCount, _frameTime));
+
+		updatedBoneCounts[step - 1] = double(simulation.totalUpdatedBoneCount()) / double(_frameCount);
+	}
+
+	/*Step 5 evaluates the crowd without the hierarchy evaluators*/
+	std::cout << "Bones recomposed per frame :";
+
+	for (int step = 1; step <= stepCount; ++step)
+	{
+		if (step == 5)
+			continue;
+
+		std::cout << " " << names[step - 1] << " " << std::setprecision(3) << updatedBoneCounts[step - 1] 
+				  << (step < stepCount ? "," : "");
+	}
+
+	std::cout << std::endl;
+
+	HeadlessRecord const& record = getHeadlessRecord();
+
+	std::cout << "Recorded " << record.m_skinningPoseCount << " palettes and " << record.m_lineCount << " lines" << std::endl;
+
+	return true;
+}
+
+/// Sort the frame times and compute the mean and the percentiles
+FrameReplayResult		computeFrameStatistics(std::vector<double>& _frameTimes)
+{
+	FrameReplayResult result;
+
+	if (_frameTimes.empty())
+		return result;
+
+	std::sort(_frameTimes.begin(), _frameTimes.end());
+
+	double sum = 0.0;
+
+	for (double frameTime : _frameTimes)
+	{
+		sum += frameTime;
+	}
+
+	result.m_mean = sum / double(_frameTimes.size());
+	result.m_p50 = percentile(_frameTimes, 50.0);
+	result.m_p90 = percentile(_frameTimes, 90.0);
+	result.m_p99 = percentile(_frameTimes, 99.0);
+	result.m_max = _frameTimes.back();
+
+	return result;
+}
+
+/// Print one line of replay result
+void					printFrameReplayResult(const char* _name, FrameReplayResult const& _result)
+{
+	std::cout << std::left << std::setw(12) << _name << std::right << std::fixed << std::setprecision(2)
+			  << std::setw(10) << _result.m_mean << std::setw(10) << _result.m_p50 << std::setw(10) << _result.m_p90 
+			  << std::setw(10) << _result.m_p99 << std::setw(10) << _result.m_max << std::endl;
+	std::cout.unsetf(std::ios_base::fixed);
+}
+
+#endif // HEADLESS_ENGINE
@@ -0,0 +1,32 @@
+#pragma once
+
+#pragma region Standard
+
+#include <cstddef>
+#include <vector>
+
+#pragma endregion
+
+class ISimulation;
+
+/// Per-frame cost of a replay in microseconds
+struct FrameReplayResult
+{
+	double				m_mean = 0.0;
+	double				m_p50 = 0.0;
+	double				m_p90 = 0.0;
+	double				m_p99 = 0.0;
+	double				m_max = 0.0;
+};
+
+/// Replay
+// Update an initialized simulation _frameCount times at a fixed frame time and measure every frame
+FrameReplayResult		replayFrames(ISimulation& _simulation, size_t _frameCount, float _frameTime);
+// Replay every step of MySimulation on the headless engine, return false if the resources cannot be read
+bool					runFrameReplay(const char* _resourceDirectory, size_t _frameCount, float _frameTime);
+
+/// Statistics
+// Sort the frame times and compute the mean and the percentiles
+FrameReplayResult		computeFrameStatistics(std::vector<double>& _frameTimes);
+// Print one line of replay result
+void					printFrameReplayResult(const char* _name, FrameReplayResult const& _result);
@@ -0,0 +1,241 @@
+#pragma region Headless
+
+#include "HeadlessEngine.h"
+
+#pragma endregion
+
+#ifdef HEADLESS_ENGINE
+
+#pragma region Simulation
+
+#include "../Simulation.h"
+#include "../ResourceFile.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <iostream>
+#include <map>
+#include <string>
+
+#pragma endregion
+
+namespace
+{
+	/// Resources loaded by the headless engine
+	struct HeadlessEngine
+	{
+		std::string							m_resourceDirectory; // Directory of the .skel and .anim files
+		SkeletonFile						m_skeleton;
+		std::vector<std::string>			m_boneNames; // Null terminated copies of the bone names
+		std::map<std::string, AnimationFile>	m_animations; // Animations mapped on first use
+
+		HeadlessRecord						m_record;
+
+		bool								m_isInitialized = false;
+	};
+
+	/// Frame count and frame time used by Run
+	const size_t	g_runFrameCount = 600;
+	const float		g_runFrameTime = 1.f / 60.f;
+
+	/// Get the engine without loading anything
+	HeadlessEngine&			instance()
+	{
+		static HeadlessEngine s_engine;
+
+		return s_engine;
+	}
+
+	/// Get the engine, loading the resources from the Whitebox data layout if it was not initialized
+	HeadlessEngine&			engine()
+	{
+		/*Behave like Engine.dll which loads its resources before the simulation starts*/
+		if (!instance().m_isInitialized)
+			initHeadlessEngine("Resources/");
+
+		return instance();
+	}
+
+	/// Get a mapped animation, nullptr if it cannot be read
+	const AnimationFile*	findAnimation(const char* _animName)
+	{
+		HeadlessEngine& headless = engine();
+
+		std::map<std::string, AnimationFile>::iterator it = headless.m_animations.find(_animName);
+
+		if (it != headless.m_animations.end())
+			return &it->second;
+
+		/*The mapped file cannot be copied so it is opened in place*/
+		AnimationFile& animation = headless.m_animations[_animName];
+		std::string path = headless.m_resourceDirectory + _animName;
+
+		if (!animation.open(path.c_str()))
+		{
+			std::cout << path << " : " << animation.error() << std::endl;
+
+			headless.m_animations.erase(_animName);
+			return nullptr;
+		}
+
+		return &animation;
+	}
+
+	/// Check the bone index before reading the skeleton
+	bool					isValidBone(int _boneIndex)
+	{
+		return _boneIndex >= 0 && static_cast<size_t>(_boneIndex) < engine().m_skeleton.boneCount();
+	}
+}
+
+#pragma region Headless
+
+/// Load the skeleton from the resource directory, return false if it cannot be read
+bool					initHeadlessEngine(const char* _resourceDirectory, const char* _skeletonName)
+{
+	HeadlessEngine& headless = instance();
+
+	headless.m_isInitialized = true;
+	headless.m_resourceDirectory = _resourceDirectory;
+	headless.m_animations.clear();
+	headless.m_boneNames.clear();
+	headless.m_record = HeadlessRecord();
+
+	std::string path = headless.m_resourceDirectory + _skeletonName;
+
+	if (!headless.m_skeleton.open(path.c_str()))
+	{
+		std::cout << path << " : " << headless.m_skeleton.error() << std::endl;
+		return false;
+	}
+
+	for (size_t i = 0; i < headless.m_skeleton.boneCount(); ++i)
+	{
+		SkeletonBone const& bone = headless.m_skeleton.bone(i);
+
+		headless.m_boneNames.emplace_back(bone.m_name, bone.m_nameLength);
+	}
+
+	return true;
+}
+
+/// Clear the lines recorded during the previous frame
+void					beginHeadlessFrame()
+{
+	engine().m_record.m_lines.clear();
+}
+
+/// Get what the simulation sent to the engine
+HeadlessRecord const&	getHeadlessRecord()
+{
+	return engine().m_record;
+}
+
+#pragma endregion
+
+#pragma region Engine
+
+/// Initialize the simulation then update it at a fixed frame time instead of opening a window
+void					Run(ISimulation* pSimulation, unsigned int width, unsigned int height)
+{
+	(void)width;
+	(void)height;
+
+	pSimulation->init();
+
+	for (size_t i = 0; i < g_runFrameCount; ++i)
+	{
+		beginHeadlessFrame();
+		pSimulation->update(g_runFrameTime);
+	}
+}
+
+/// Record the palette instead of sending it to the GPU
+void					SetSkinningPose(const float* boneMatrices, size_t boneCount)
+{
+	HeadlessRecord& record = engine().m_record;
+
+	record.m_skinningPose.assign(boneMatrices, boneMatrices + boneCount * 16);
+	++record.m_skinningPoseCount;
+}
+
+size_t					GetSkeletonBoneCount()
+{
+	return engine().m_skeleton.boneCount();
+}
+
+const char*				GetSkeletonBoneName(int boneIndex)
+{
+	return isValidBone(boneIndex) ? engine().m_boneNames[boneIndex].c_str() : "";
+}
+
+int						GetSkeletonBoneIndex(const char* name)
+{
+	return engine().m_skeleton.findBone(name);
+}
+
+int						GetSkeletonBoneParentIndex(int boneIndex)
+{
+	return isValidBone(boneIndex) ? engine().m_skeleton.bone(boneIndex).m_parentIndex : -1;
+}
+
+void					GetSkeletonBoneLocalBindTransform(int boneIndex, float& posX, float& posY, float& posZ, 
+														  float& quatW, float& quatX, float& quatY, float& quatZ)
+{
+	Transform bind;
+	bind.m_rotation = LibMath::Quaternion(1.f, 0.f, 0.f, 0.f);
+
+	if (isValidBone(boneIndex))
+		bind = engine().m_skeleton.getBindTransform(boneIndex);
+
+	posX = bind.m_position.m_x;
+	posY = bind.m_position.m_y;
+	posZ = bind.m_position.m_z;
+	quatW = bind.m_rotation.m_a;
+	quatX = bind.m_rotation.m_b;
+	quatY = bind.m_rotation.m_c;
+	quatZ = bind.m_rotation.m_d;
+}
+
+size_t					GetAnimKeyCount(const char* animName)
+{
+	const AnimationFile* animation = findAnimation(animName);
+
+	return animation != nullptr ? animation->keyCount() : 0;
+}
+
+void					GetAnimLocalBoneTransform(const char* animName, int boneIndex, int keyFrameIndex, 
+												  float& posX, float& posY, float& posZ, 
+												  float& quatW, float& quatX, float& quatY, float& quatZ)
+{
+	const AnimationFile* animation = findAnimation(animName);
+
+	Transform key;
+	key.m_rotation = LibMath::Quaternion(1.f, 0.f, 0.f, 0.f);
+
+	if (animation != nullptr && boneIndex >= 0 && keyFrameIndex >= 0)
+		key = animation->getKey(boneIndex, keyFrameIndex);
+
+	posX = key.m_position.m_x;
+	posY = key.m_position.m_y;
+	posZ = key.m_position.m_z;
+	quatW = key.m_rotation.m_a;
+	quatX = key.m_rotation.m_b;
+	quatY = key.m_rotation.m_c;
+	quatZ = key.m_rotation.m_d;
+}
+
+/// Record the line instead of drawing it
+void					DrawLine(float x0, float y0, float z0, float x1, float y1, float z1, float r, float g, float b)
+{
+	HeadlessRecord& record = engine().m_record;
+
+	record.m_lines.push_back({ { x0, y0, z0 }, { x1, y1, z1 }, { r, g, b } });
+	++record.m_lineCount;
+}
+
+#pragma endregion
+
+#endif // HEADLESS_ENGINE
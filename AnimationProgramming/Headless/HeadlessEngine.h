@@ -0,0 +1,45 @@
+#pragma once
+
+#pragma region Simulation
+
+#include "../Engine.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstddef>
+#include <vector>
+
+#pragma endregion
+
+/// Line recorded instead of being drawn
+struct HeadlessLine
+{
+	float					m_start[3];
+	float					m_end[3];
+	float					m_color[3];
+};
+
+/// What the simulation sent to the headless engine
+struct HeadlessRecord
+{
+	std::vector<float>			m_skinningPose; // Last palette sent with SetSkinningPose, 16 floats per bone
+	std::vector<HeadlessLine>	m_lines; // Lines drawn since the beginning of the frame
+
+	size_t						m_skinningPoseCount = 0; // Number of palettes sent since the engine was initialized
+	size_t						m_lineCount = 0; // Number of lines drawn since the engine was initialized
+};
+
+/// Initialize
+// Load the skeleton from the resource directory, return false if it cannot be read
+bool					initHeadlessEngine(const char* _resourceDirectory, 
+										   const char* _skeletonName = "ThirdPersonWalk.skel");
+
+/// Frame
+// Clear the lines recorded during the previous frame
+void					beginHeadlessFrame();
+
+/// Getter
+// Get what the simulation sent to the engine
+HeadlessRecord const&	getHeadlessRecord();
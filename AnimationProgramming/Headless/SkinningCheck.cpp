@@ -0,0 +1,262 @@
+#pragma region Headless
+
+#include "SkinningCheck.h"
+#include "HeadlessEngine.h"
+
+#pragma endregion
+
+#ifdef HEADLESS_ENGINE
+
+#pragma region Simulation
+
+#include "../MySimulation.h"
+#include "../ResourceFile.h"
+#include "../Skinning.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#pragma endregion
+
+namespace
+{
+	/// Largest distance accepted between two palettes of the same skinning, in mesh units (centimeters)
+	const float			g_tolerance = 1e-3f;
+	/// Largest distance accepted between the dual quaternion and the matrix skinning of a vertex with a single bone :
+	/// interpolated rotations are up to 1e-4 away from unit length, the matrices scale the mesh by that much twice
+	/// while the dual quaternions are normalized
+	const float			g_rigidTolerance = 0.1f;
+
+	/// Palette formats compared with the Matrix4 palette
+	const PaletteFormat	g_formats[] = { PaletteFormat::Matrix4, PaletteFormat::Affine, PaletteFormat::DualQuaternion };
+
+	/// Distances between the positions skinned with the Matrix4 palette and with another palette
+	struct SkinningDistance
+	{
+		float			m_largestRigid = 0.f; // Largest distance of the vertices driven by a single bone
+		float			m_largestBlended = 0.f; // Largest distance of the vertices driven by several bones
+		double			m_blendedSum = 0.0; // Sum of the distances of the vertices driven by several bones
+		size_t			m_blendedCount = 0; // Number of distances in the sum
+	};
+
+	/// Initialize a simulation on the headless engine without printing the bone hierarchy
+	void				initSilently(MySimulation& _simulation)
+	{
+		ISimulation& simulation = _simulation;
+
+		std::streambuf* output = std::cout.rdbuf(nullptr);
+		simulation.init();
+		std::cout.rdbuf(output);
+		std::cout.clear();
+	}
+
+	/// Update a simulation for one frame and copy the palette it sent
+	std::vector<float>	updateAndRecord(MySimulation& _simulation, float _frameTime)
+	{
+		ISimulation& simulation = _simulation;
+
+		beginHeadlessFrame();
+		simulation.update(_frameTime);
+
+		return getHeadlessRecord().m_skinningPose;
+	}
+
+	/// Skin a vertex with a palette recorded in any format
+	LibMath::Vector3	skinRecordedVertex(MeshVertex const& _vertex, PaletteFormat _format, std::vector<float> const& _pose)
+	{
+		switch (_format)
+		{
+		case PaletteFormat::Affine:
+			return skinVertex(_vertex, reinterpret_cast<const AffineMatrix*>(_pose.data()));
+		case PaletteFormat::DualQuaternion:
+			return skinVertex(_vertex, reinterpret_cast<const DualQuaternion*>(_pose.data()));
+		default:
+			return skinVertex(_vertex, reinterpret_cast<const LibMath::Matrix4*>(_pose.data()));
+		}
+	}
+
+	/// Compose the local bind transforms and check that the mannequin stands, Z up, on its feet
+	bool				checkBindPose(SkeletonFile const& _skeleton)
+	{
+		std::vector<Transform> worldPose(_skeleton.boneCount());
+
+		/*The file stores the parents before their children*/
+		for (size_t i = 0; i < _skeleton.boneCount(); ++i)
+		{
+			int parentIndex = _skeleton.bone(i).m_parentIndex;
+			Transform local = _skeleton.getBindTransform(i);
+
+			worldPose[i] = parentIndex < 0 ? local : local * worldPose[parentIndex];
+		}
+
+		int pelvis = _skeleton.findBone("pelvis");
+		int head = _skeleton.findBone("head");
+		int feet[] = { _skeleton.findBone("foot_l"), _skeleton.findBone("foot_r") };
+
+		/*Other skeletons are not checked*/
+		if (pelvis < 0 || head < 0 || feet[0] < 0 || feet[1] < 0)
+			return true;
+
+		if (worldPose[head].m_position.m_z <= worldPose[pelvis].m_position.m_z)
+			return false;
+
+		/*The ankles are a few centimeters above the ground*/
+		for (int foot : feet)
+		{
+			if (std::fabs(worldPose[foot].m_position.m_z) > 20.f)
+				return false;
+		}
+
+		return true;
+	}
+
+	/// Return true if a single bone drives the vertex
+	bool				isRigid(MeshVertex const& _vertex)
+	{
+		float sum = _vertex.m_boneWeights[0] + _vertex.m_boneWeights[1] + _vertex.m_boneWeights[2] + 
+					_vertex.m_boneWeights[3];
+		float largest = std::fmax(std::fmax(_vertex.m_boneWeights[0], _vertex.m_boneWeights[1]), 
+								  std::fmax(_vertex.m_boneWeights[2], _vertex.m_boneWeights[3]));
+
+		return largest >= 0.999f * sum;
+	}
+}
+
+/// Check that the composed bind pose of the mannequin stands on its feet, then run the skinned steps with every palette
+/// format side by side and skin the mesh on the CPU with each, return false if the resources cannot be read, if the
+/// mannequin does not stand or if the skinned positions differ
+bool					runSkinningCheck(const char* _resourceDirectory, size_t _frameCount, float _frameTime)
+{
+	if (!initHeadlessEngine(_resourceDirectory))
+		return false;
+
+	SkeletonFile skeleton;
+	std::string skeletonPath = std::string(_resourceDirectory) + "ThirdPersonWalk.skel";
+
+	if (!skeleton.open(skeletonPath.c_str()))
+	{
+		std::cerr << skeletonPath << " : " << skeleton.error() << std::endl;
+		return false;
+	}
+
+	MeshFile mesh;
+	std::string meshPath = std::string(_resourceDirectory) + "SK_Mannequin.msh";
+
+	if (!mesh.open(meshPath.c_str()))
+	{
+		std::cerr << meshPath << " : " << mesh.error() << std::endl;
+		return false;
+	}
+
+	const size_t formatCount = sizeof(g_formats) / sizeof(g_formats[0]);
+	const MeshVertex* vertices = mesh.vertices();
+	size_t boneCount = 0;
+	bool isValid = checkBindPose(skeleton);
+
+	std::cout << "Bind pose of " << skeletonPath << " : head above the pelvis and feet near z=0" 
+			  << (isValid ? " ok" : " FAILED") << std::endl;
+
+	std::cout << "Skinning check of " << mesh.vertexCount() << " vertices over " << _frameCount 
+			  << " frames, distance to the Matrix4 palette" << std::endl;
+
+	for (int step = 3; step <= 7; ++step)
+	{
+		MySimulation simulations[formatCount];
+		SkinningDistance distances[formatCount];
+
+		for (size_t format = 0; format < formatCount; ++format)
+		{
+			simulations[format].selectStep(step);
+			simulations[format].setResourceDirectory(_resourceDirectory);
+			simulations[format].selectPaletteFormat(g_formats[format]);
+
+			initSilently(simulations[format]);
+		}
+
+		std::vector<LibMath::Vector3> reference(mesh.vertexCount());
+
+		for (size_t frame = 0; frame < _frameCount; ++frame)
+		{
+			/*Every simulation sees the same frame times so they send the same pose*/
+			for (size_t format = 0; format < formatCount; ++format)
+			{
+				std::vector<float> pose = updateAndRecord(simulations[format], _frameTime);
+
+				if (format == 0)
+				{
+					boneCount = pose.size() / 16;
+				}
+
+				if (pose.size() != paletteSubmitCount(g_formats[format], boneCount) * 16)
+				{
+					std::cerr << "step" << step << " : the " << paletteFormatName(g_formats[format]) << " palette has " 
+							  << pose.size() << " floats" << std::endl;
+					return false;
+				}
+
+				for (size_t i = 0; i < mesh.vertexCount(); ++i)
+				{
+					LibMath::Vector3 position = skinRecordedVertex(vertices[i], g_formats[format], pose);
+
+					if (format == 0)
+					{
+						reference[i] = position;
+						continue;
+					}
+
+					LibMath::Vector3 offset = position - reference[i];
+					float distance = std::sqrt(offset.m_x * offset.m_x + offset.m_y * offset.m_y + offset.m_z * offset.m_z);
+
+					SkinningDistance& result = distances[format];
+
+					if (isRigid(vertices[i]))
+					{
+						result.m_largestRigid = std::fmax(result.m_largestRigid, distance);
+					}
+					else
+					{
+						result.m_largestBlended = std::fmax(result.m_largestBlended, distance);
+						result.m_blendedSum += distance;
+						++result.m_blendedCount;
+					}
+				}
+			}
+		}
+
+		for (size_t format = 1; format < formatCount; ++format)
+		{
+			SkinningDistance const& result = distances[format];
+
+			/*Dual quaternions only match the matrices on rigid vertices, blending them is the point*/
+			bool isBlendingExact = g_formats[format] != PaletteFormat::DualQuaternion;
+			bool isFormatValid = isBlendingExact ? std::fmax(result.m_largestRigid, result.m_largestBlended) <= g_tolerance :
+												   result.m_largestRigid <= g_rigidTolerance;
+
+			std::cout << "  step" << step << " " << paletteFormatName(g_formats[format]) << " : rigid " 
+					  << result.m_largestRigid << ", blended largest " << result.m_largestBlended << " mean " 
+					  << (result.m_blendedCount > 0 ? result.m_blendedSum / double(result.m_blendedCount) : 0.0)
+					  << (isFormatValid ? " ok" : " FAILED") << std::endl;
+
+			isValid = isValid && isFormatValid;
+		}
+	}
+
+	std::cout << "Palette of " << boneCount << " bones :";
+
+	for (PaletteFormat format : g_formats)
+	{
+		std::cout << " " << paletteSize(format, boneCount) << " bytes as " << paletteFormatName(format) << ",";
+	}
+
+	std::cout << std::endl;
+
+	return isValid;
+}
+
+#endif // HEADLESS_ENGINE
@@ -0,0 +1,13 @@
+#pragma once
+
+#pragma region Standard
+
+#include <cstddef>
+
+#pragma endregion
+
+/// Check
+// Check that the composed bind pose of the mannequin stands on its feet, then run the skinned steps with every palette
+// format side by side and skin the mesh on the CPU with each, return false if the resources cannot be read, if the
+// mannequin does not stand or if the skinned positions differ
+bool					runSkinningCheck(const char* _resourceDirectory, size_t _frameCount, float _frameTime);
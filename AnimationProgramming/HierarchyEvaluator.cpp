@@ -0,0 +1,92 @@
+#include "HierarchyEvaluator.h"
+
+#pragma region Standard
+
+#include <cassert>
+#include <algorithm>
+
+#pragma endregion
+
+/// Copy the hierarchy and the local pose, every bone starts dirty
+void				HierarchyEvaluator::initialize(std::vector<int> const& _parentIndices,
+												   std::vector<Transform> const& _localPose)
+{
+	assert(_parentIndices.size() == _localPose.size());
+
+	m_parentIndices = _parentIndices;
+	m_localPose = _localPose;
+	m_worldPose.resize(m_localPose.size());
+	m_isDirty.assign(m_localPose.size(), 1);
+
+	m_firstDirtyBone = 0;
+	m_dirtyBoneCount = m_localPose.size();
+
+	m_updatedBoneCount = 0;
+	m_totalUpdatedBoneCount = 0;
+	m_evaluationCount = 0;
+}
+
+/// Change the local transform of a bone and mark it dirty
+void				HierarchyEvaluator::setLocalTransform(size_t _bone, Transform const& _localTransform)
+{
+	m_localPose[_bone] = _localTransform;
+
+	markDirty(_bone);
+}
+
+/// Mark a bone so the next evaluate recomposes it and its subtree
+void				HierarchyEvaluator::markDirty(size_t _bone)
+{
+	if (m_isDirty[_bone])
+		return;
+
+	m_isDirty[_bone] = 1;
+	m_firstDirtyBone = m_dirtyBoneCount == 0 ? _bone : std::min(m_firstDirtyBone, _bone);
+	++m_dirtyBoneCount;
+}
+
+/// Recompose the dirty bones and their subtrees, return the number of bones recomposed
+size_t				HierarchyEvaluator::evaluate()
+{
+	++m_evaluationCount;
+	m_updatedBoneCount = 0;
+
+	/*Nothing moved since the last evaluate, the world pose is still valid*/
+	if (m_dirtyBoneCount == 0)
+		return 0;
+
+	size_t boneCount = m_parentIndices.size();
+
+	/*Parents are stored before their children so a dirty parent is seen before its subtree*/
+	for (size_t i = m_firstDirtyBone; i < boneCount; ++i)
+	{
+		int parentIndex = m_parentIndices[i];
+
+		if (parentIndex != -1 && m_isDirty[parentIndex])
+		{
+			m_isDirty[i] = 1;
+		}
+
+		if (!m_isDirty[i])
+			continue;
+
+		if (parentIndex == -1)
+		{
+			m_worldPose[i] = m_localPose[i];
+		}
+		else
+		{
+			m_worldPose[i] = m_localPose[i] * m_worldPose[parentIndex];
+		}
+
+		++m_updatedBoneCount;
+	}
+
+	/*The flags are cleared after the pass because the children read the flag of their parent*/
+	std::fill(m_isDirty.begin() + m_firstDirtyBone, m_isDirty.end(), uint8_t(0));
+
+	m_dirtyBoneCount = 0;
+	m_totalUpdatedBoneCount += m_updatedBoneCount;
+
+	return m_updatedBoneCount;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#pragma region Animation
+
+#include "Transform.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#pragma endregion
+
+/// World transforms of a hierarchy, recomposed only for the bones whose local transform changed and their children
+class HierarchyEvaluator
+{
+	/// Variables
+	std::vector<int>		m_parentIndices; // Parent of every bone, -1 for the root, always lower than the bone
+	std::vector<Transform>	m_localPose; // Local transform of every bone, relative to its parent
+	std::vector<Transform>	m_worldPose; // World transform of every bone, valid after evaluate
+	std::vector<uint8_t>	m_isDirty; // 1 if the bone must be recomposed by the next evaluate
+
+	size_t					m_firstDirtyBone = 0; // Lowest dirty bone, the bones before it are skipped
+	size_t					m_dirtyBoneCount = 0; // Bones marked since the last evaluate, without their children
+
+	size_t					m_updatedBoneCount = 0; // Bones recomposed by the last evaluate
+	size_t					m_totalUpdatedBoneCount = 0; // Bones recomposed since initialize
+	size_t					m_evaluationCount = 0; // Calls to evaluate since initialize
+
+public:
+
+	/// Initialize
+	// Copy the hierarchy and the local pose, every bone starts dirty
+	void					initialize(std::vector<int> const& _parentIndices, std::vector<Transform> const& _localPose);
+
+	/// Update
+	// Change the local transform of a bone and mark it dirty
+	void					setLocalTransform(size_t _bone, Transform const& _localTransform);
+	// Mark a bone so the next evaluate recomposes it and its subtree
+	void					markDirty(size_t _bone);
+	// Recompose the dirty bones and their subtrees, return the number of bones recomposed
+	size_t					evaluate();
+
+	/// Getter
+	size_t					boneCount() const { return m_parentIndices.size(); }
+	Transform const&		localTransform(size_t _bone) const { return m_localPose[_bone]; }
+	Transform const&		worldTransform(size_t _bone) const { return m_worldPose[_bone]; }
+	const Transform*		worldPose() const { return m_worldPose.data(); }
+	size_t					updatedBoneCount() const { return m_updatedBoneCount; }
+	size_t					totalUpdatedBoneCount() const { return m_totalUpdatedBoneCount; }
+	size_t					evaluationCount() const { return m_evaluationCount; }
+};
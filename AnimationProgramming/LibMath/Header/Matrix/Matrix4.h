@@ -8,6 +8,9 @@
 /// Vector librairies
 #include "Vector/Vector.h"
 
+/// Standard librairies
+#include <cstddef>
+
 #pragma endregion
 
 namespace LibMath
@@ -48,6 +51,10 @@ namespace LibMath
 					Matrix4		Adjugate(Matrix4&);
 					/// Return matrix to the power of -1
 					Matrix4		GetInverse() const;
+					/// Return the inverse of an orthonormal rotation and translation matrix
+					Matrix4		GetRigidInverse() const;
+					/// Return the inverse of a scale, rotation and translation matrix
+					Matrix4		GetAffineInverse() const;
 #pragma endregion
 
 #pragma region Transformation
@@ -111,7 +118,8 @@ namespace LibMath
 #pragma endregion
 
 		/// Variables
-		float m_matrix[4][4];
+		/// Aligned on 16 bytes so every row can be loaded in one vector register
+		alignas(16) float m_matrix[4][4];
 
 	}; // !Class Matrix4
 
@@ -120,6 +128,9 @@ namespace LibMath
 	/// Operator to multiply a vector 4 and a matrix 4
 	Vector4 operator*(const Vector4&, const Matrix4&);
 
+	/// Multiply _count pairs of matrices (_result[i] = _lhs[i] * _rhs[i]) with the active instruction set
+	void	multiply(const Matrix4* _lhs, const Matrix4* _rhs, Matrix4* _result, size_t _count);
+
 #pragma endregion
 
 } // !Namespace LibMath
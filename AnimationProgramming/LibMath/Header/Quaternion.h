@@ -15,6 +15,14 @@
 
 namespace LibMath
 {
+	/// Interpolation used between two rotations, from the most exact to the cheapest
+	enum class RotationInterpolation
+	{
+		Slerp, // Constant angular velocity, one acos and three sin
+		ApproximateSlerp, // Nlerp with a polynomial correction of the parameter, close to slerp
+		Nlerp // Normalized linear interpolation, shortest path but not constant velocity
+	};
+
 	class Quaternion
 	{
 	public :
@@ -31,6 +39,23 @@ namespace LibMath
 
 	}; // !Class Quaternion.
 
+	/// Rotations stored as one array per component, so several rotations fill a vector register
+	struct QuaternionArrays
+	{
+		const float* m_a;
+		const float* m_b;
+		const float* m_c;
+		const float* m_d;
+	};
+
+	/// Vectors stored as one array per component
+	struct Vector3Arrays
+	{
+		float* m_x;
+		float* m_y;
+		float* m_z;
+	};
+
 
 	/// Out of class operators.
 	Quaternion	operator-(Quaternion const& _other);
@@ -51,7 +76,15 @@ namespace LibMath
 	Quaternion	normalize(Quaternion const& _other);
 	Quaternion	inverse(Quaternion const& _other);
 	Quaternion	slerp(Quaternion const& _quat1, Quaternion const& _quat2, float _scalar);
+	Quaternion	nlerp(Quaternion const& _quat1, Quaternion const& _quat2, float _scalar);
+	Quaternion	approximateSlerp(Quaternion const& _quat1, Quaternion const& _quat2, float _scalar);
+	Quaternion	interpolateRotation(Quaternion const& _quat1, Quaternion const& _quat2, float _scalar, 
+									RotationInterpolation _interpolation);
+	const char*	rotationInterpolationName(RotationInterpolation _interpolation);
 	Vector4		rotatePoint(Quaternion const&, Vector4 const&);
+	Vector3		rotate(Quaternion const& _rotation, Vector3 const& _vector);
+	void		rotate(QuaternionArrays const& _rotations, Vector3Arrays const& _vectors, Vector3Arrays const& _result, 
+					   size_t _count);
 	Matrix4		toMatrix4(Quaternion const& _other);
 
 	float		floatSelect(float _comparand);
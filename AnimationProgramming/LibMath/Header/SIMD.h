@@ -0,0 +1,46 @@
+#ifndef __LIBMATH__SIMD_H__
+#define __LIBMATH__SIMD_H__
+
+#pragma region Define
+
+///Define
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define LIBMATH_X86 1
+#else
+#define LIBMATH_X86 0
+#endif
+
+/// Let GCC and Clang emit AVX code in a single function without compiling the whole project with -mavx
+#if LIBMATH_X86 && (defined(__GNUC__) || defined(__clang__))
+#define LIBMATH_TARGET_AVX __attribute__((target("avx")))
+#define LIBMATH_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define LIBMATH_TARGET_AVX
+#define LIBMATH_TARGET_AVX2
+#endif
+
+#pragma endregion
+
+namespace LibMath
+{
+	/// Instruction sets the vectorized kernels can run on, ordered from the oldest to the newest
+	enum class InstructionSet
+	{
+		Scalar,
+		SSE,
+		AVX,
+		AVX2
+	};
+
+	/// Return the newest instruction set supported by the processor and the operating system
+	InstructionSet	detectInstructionSet();
+	/// Return the instruction set currently used by the vectorized kernels
+	InstructionSet	activeInstructionSet();
+	/// Force the kernels to an instruction set (clamped to the supported one) and return the one selected
+	InstructionSet	selectInstructionSet(InstructionSet _instructionSet);
+	/// Return the name of an instruction set
+	const char*		instructionSetName(InstructionSet _instructionSet);
+
+} // !Namespace LibMath
+
+#endif // !__LIBMATH__SIMD_H__
@@ -172,7 +172,7 @@ namespace LibMath
 #pragma region Out class operator
 
 	///Check if degree lhs is equal to degree rhs
-	bool				LibMath::operator==(Degree lhs, Degree rhs)
+	bool				operator==(Degree lhs, Degree rhs)
 	{
 		// Call trigonometry function to adjust the precision
 		return almostEqual(lhs.degree(), rhs.degree());
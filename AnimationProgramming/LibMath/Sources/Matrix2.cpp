@@ -1,6 +1,9 @@
 ///Header
 #include "Matrix/Matrix2.h"
 
+#include <cfloat>
+#include <cmath>
+
 namespace LibMath
 {
 #pragma region Constructor
@@ -93,10 +96,10 @@ namespace LibMath
 	{
 		*this = _other;
 
-		this->m_matrix[0][0] = std::powf(-1.0f, 2) * this->m_matrix[0][0];
-		this->m_matrix[0][1] = std::powf(-1.0f, 3) * this->m_matrix[0][1];
-		this->m_matrix[1][0] = std::powf(-1.0f, 3) * this->m_matrix[1][0];
-		this->m_matrix[1][1] = std::powf(-1.0f, 4) * this->m_matrix[1][1];
+		this->m_matrix[0][0] = std::pow(-1.0f, 2) * this->m_matrix[0][0];
+		this->m_matrix[0][1] = std::pow(-1.0f, 3) * this->m_matrix[0][1];
+		this->m_matrix[1][0] = std::pow(-1.0f, 3) * this->m_matrix[1][0];
+		this->m_matrix[1][1] = std::pow(-1.0f, 4) * this->m_matrix[1][1];
 
 		return *this;
 	}
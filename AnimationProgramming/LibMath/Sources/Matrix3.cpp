@@ -1,6 +1,9 @@
 ///Header
 #include "Matrix/Matrix3.h"
 
+#include <cfloat>
+#include <cmath>
+
 namespace LibMath
 {
 #pragma region Constructor
@@ -202,8 +205,8 @@ namespace LibMath
 	/// Calcul the rotation around x axis
 	Matrix3		Matrix3::XRotation(float _angle, bool _isRowMajor)
 	{
-		float sinAngle = sinf(_angle);
-		float cosAngle = cosf(_angle);
+		float sinAngle = std::sin(_angle);
+		float cosAngle = std::cos(_angle);
 
 		if (_isRowMajor)
 		{
@@ -233,8 +236,8 @@ namespace LibMath
 	/// Calcul the rotation around y axis
 	Matrix3		Matrix3::YRotation(float _angle, bool isRowMajor)
 	{
-		float sinAngle = sinf(_angle);
-		float cosAngle = cosf(_angle);
+		float sinAngle = std::sin(_angle);
+		float cosAngle = std::cos(_angle);
 
 		if (isRowMajor)
 		{
@@ -262,8 +265,8 @@ namespace LibMath
 	/// Calcul the rotation around z axis
 	Matrix3		Matrix3::ZRotation(float _angle, bool _isRowMajor)
 	{
-		float sinAngle = sinf(_angle);
-		float cosAngle = cosf(_angle);
+		float sinAngle = std::sin(_angle);
+		float cosAngle = std::cos(_angle);
 
 		if (_isRowMajor)
 		{
@@ -1,8 +1,164 @@
 ///Header
 #include "Matrix/Matrix4.h"
 
+#include <cfloat>
+#include <cmath>
+
+#include "SIMD.h"
+
+#if LIBMATH_X86
+#include <immintrin.h>
+#endif
+
 namespace LibMath
 {
+#pragma region Multiplication kernels
+
+	namespace
+	{
+		/// Signature shared by every matrix multiplication kernel
+		typedef void (*MultiplyKernel)(const Matrix4*, const Matrix4*, Matrix4*, size_t);
+
+		/// Multiply the matrices with the scalar triple loop
+		void		multiplyScalar(const Matrix4* _lhs, const Matrix4* _rhs, Matrix4* _result, size_t _count)
+		{
+			for (size_t n = 0; n < _count; ++n)
+			{
+				// Compute in a temporary so the result can alias one of the operands
+				float result[4][4];
+
+				for (int i = 0; i < 4; ++i)
+				{
+					for (int j = 0; j < 4; ++j)
+					{
+						result[i][j] = _lhs[n].m_matrix[i][0] * _rhs[n].m_matrix[0][j] +
+									   _lhs[n].m_matrix[i][1] * _rhs[n].m_matrix[1][j] +
+									   _lhs[n].m_matrix[i][2] * _rhs[n].m_matrix[2][j] +
+									   _lhs[n].m_matrix[i][3] * _rhs[n].m_matrix[3][j];
+					}
+				}
+
+				for (int i = 0; i < 16; ++i)
+				{
+					_result[n].m_matrix[i / 4][i % 4] = result[i / 4][i % 4];
+				}
+			}
+		}
+
+#if LIBMATH_X86
+		/// Multiply the matrices one row at a time with 128 bits registers
+		void		multiplySSE(const Matrix4* _lhs, const Matrix4* _rhs, Matrix4* _result, size_t _count)
+		{
+			for (size_t n = 0; n < _count; ++n)
+			{
+				const float* lhs = &_lhs[n].m_matrix[0][0];
+				const float* rhs = &_rhs[n].m_matrix[0][0];
+				float* result = &_result[n].m_matrix[0][0];
+
+				// Load every row of the right matrix first so the result can alias it
+				__m128 row0 = _mm_loadu_ps(rhs);
+				__m128 row1 = _mm_loadu_ps(rhs + 4);
+				__m128 row2 = _mm_loadu_ps(rhs + 8);
+				__m128 row3 = _mm_loadu_ps(rhs + 12);
+
+				for (int i = 0; i < 4; ++i)
+				{
+					__m128 line = _mm_loadu_ps(lhs + 4 * i);
+
+					__m128 sum = _mm_mul_ps(_mm_shuffle_ps(line, line, 0x00), row0);
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(line, line, 0x55), row1));
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(line, line, 0xAA), row2));
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(line, line, 0xFF), row3));
+
+					_mm_storeu_ps(result + 4 * i, sum);
+				}
+			}
+		}
+
+		/// Multiply the matrices two rows at a time with 256 bits registers
+		LIBMATH_TARGET_AVX
+		void		multiplyAVX(const Matrix4* _lhs, const Matrix4* _rhs, Matrix4* _result, size_t _count)
+		{
+			for (size_t n = 0; n < _count; ++n)
+			{
+				const float* lhs = &_lhs[n].m_matrix[0][0];
+				const float* rhs = &_rhs[n].m_matrix[0][0];
+				float* result = &_result[n].m_matrix[0][0];
+
+				// Duplicate every row of the right matrix in both 128 bits lanes
+				__m256 row0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs));
+				__m256 row1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 4));
+				__m256 row2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 8));
+				__m256 row3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 12));
+
+				for (int i = 0; i < 4; i += 2)
+				{
+					// Each lane holds one row of the left matrix
+					__m256 lines = _mm256_loadu_ps(lhs + 4 * i);
+
+					__m256 sum = _mm256_mul_ps(_mm256_permute_ps(lines, 0x00), row0);
+					sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(lines, 0x55), row1));
+					sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(lines, 0xAA), row2));
+					sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(lines, 0xFF), row3));
+
+					_mm256_storeu_ps(result + 4 * i, sum);
+				}
+			}
+		}
+
+		/// Multiply the matrices two rows at a time with fused multiply-add
+		LIBMATH_TARGET_AVX2
+		void		multiplyAVX2(const Matrix4* _lhs, const Matrix4* _rhs, Matrix4* _result, size_t _count)
+		{
+			for (size_t n = 0; n < _count; ++n)
+			{
+				const float* lhs = &_lhs[n].m_matrix[0][0];
+				const float* rhs = &_rhs[n].m_matrix[0][0];
+				float* result = &_result[n].m_matrix[0][0];
+
+				__m256 row0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs));
+				__m256 row1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 4));
+				__m256 row2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 8));
+				__m256 row3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 12));
+
+				for (int i = 0; i < 4; i += 2)
+				{
+					__m256 lines = _mm256_loadu_ps(lhs + 4 * i);
+
+					__m256 sum = _mm256_mul_ps(_mm256_permute_ps(lines, 0x00), row0);
+					sum = _mm256_fmadd_ps(_mm256_permute_ps(lines, 0x55), row1, sum);
+					sum = _mm256_fmadd_ps(_mm256_permute_ps(lines, 0xAA), row2, sum);
+					sum = _mm256_fmadd_ps(_mm256_permute_ps(lines, 0xFF), row3, sum);
+
+					_mm256_storeu_ps(result + 4 * i, sum);
+				}
+			}
+		}
+#endif
+
+		/// Return the multiplication kernel matching an instruction set
+		MultiplyKernel	multiplyKernel(InstructionSet _instructionSet)
+		{
+#if LIBMATH_X86
+			switch (_instructionSet)
+			{
+			case InstructionSet::AVX2:
+				return multiplyAVX2;
+			case InstructionSet::AVX:
+				return multiplyAVX;
+			case InstructionSet::SSE:
+				return multiplySSE;
+			default:
+				return multiplyScalar;
+			}
+#else
+			return multiplyScalar;
+#endif
+		}
+	}
+
+#pragma endregion
+
 #pragma region Constructor
 	
 	/// Constructor to create 4x4 a identity matrix 
@@ -157,6 +313,72 @@ namespace LibMath
 
 		return resultMatrix;
 	}
+	/// Return the inverse of an orthonormal rotation and translation matrix
+	Matrix4		Matrix4::GetRigidInverse() const
+	{
+		Matrix4 resultMatrix;
+
+		// The inverse of an orthonormal rotation is its transpose
+		for (int i = 0; i < 3; ++i)
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				resultMatrix.m_matrix[i][j] = this->m_matrix[j][i];
+			}
+		}
+
+		// Bring the translation back through the inverse rotation
+		for (int j = 0; j < 3; ++j)
+		{
+			resultMatrix.m_matrix[3][j] = -(this->m_matrix[3][0] * resultMatrix.m_matrix[0][j] +
+											this->m_matrix[3][1] * resultMatrix.m_matrix[1][j] +
+											this->m_matrix[3][2] * resultMatrix.m_matrix[2][j]);
+		}
+
+		return resultMatrix;
+	}
+	/// Return the inverse of a scale, rotation and translation matrix
+	Matrix4		Matrix4::GetAffineInverse() const
+	{
+		const float (&matrix)[4][4] = this->m_matrix;
+		Matrix4 resultMatrix;
+
+		// Cofactors of the first row of the 3x3 block
+		float cofactor00 = matrix[1][1] * matrix[2][2] - matrix[1][2] * matrix[2][1];
+		float cofactor01 = matrix[1][2] * matrix[2][0] - matrix[1][0] * matrix[2][2];
+		float cofactor02 = matrix[1][0] * matrix[2][1] - matrix[1][1] * matrix[2][0];
+
+		float det = matrix[0][0] * cofactor00 + matrix[0][1] * cofactor01 + matrix[0][2] * cofactor02;
+
+		// Check determinant is not zero
+		if (det == 0.0f)
+			return resultMatrix;
+
+		float invDet = 1.0f / det;
+
+		// Adjugate of the 3x3 block divided by its determinant
+		resultMatrix.m_matrix[0][0] = cofactor00 * invDet;
+		resultMatrix.m_matrix[0][1] = (matrix[0][2] * matrix[2][1] - matrix[0][1] * matrix[2][2]) * invDet;
+		resultMatrix.m_matrix[0][2] = (matrix[0][1] * matrix[1][2] - matrix[0][2] * matrix[1][1]) * invDet;
+
+		resultMatrix.m_matrix[1][0] = cofactor01 * invDet;
+		resultMatrix.m_matrix[1][1] = (matrix[0][0] * matrix[2][2] - matrix[0][2] * matrix[2][0]) * invDet;
+		resultMatrix.m_matrix[1][2] = (matrix[0][2] * matrix[1][0] - matrix[0][0] * matrix[1][2]) * invDet;
+
+		resultMatrix.m_matrix[2][0] = cofactor02 * invDet;
+		resultMatrix.m_matrix[2][1] = (matrix[0][1] * matrix[2][0] - matrix[0][0] * matrix[2][1]) * invDet;
+		resultMatrix.m_matrix[2][2] = (matrix[0][0] * matrix[1][1] - matrix[0][1] * matrix[1][0]) * invDet;
+
+		// Bring the translation back through the inverse 3x3 block
+		for (int j = 0; j < 3; ++j)
+		{
+			resultMatrix.m_matrix[3][j] = -(matrix[3][0] * resultMatrix.m_matrix[0][j] +
+											matrix[3][1] * resultMatrix.m_matrix[1][j] +
+											matrix[3][2] * resultMatrix.m_matrix[2][j]);
+		}
+
+		return resultMatrix;
+	}
 
 #pragma endregion
 
@@ -167,8 +389,8 @@ namespace LibMath
 	{
 		Matrix4 matrix4;
 
-		float sinAngle = sinf(_angle);
-		float cosAngle = cosf(_angle);
+		float sinAngle = std::sin(_angle);
+		float cosAngle = std::cos(_angle);
 
 
 		matrix4.m_matrix[0][0] = 1.0f;
@@ -197,8 +419,8 @@ namespace LibMath
 	{
 		Matrix4 matrix4;
 
-		float sinAngle = sinf(_angle);
-		float cosAngle = cosf(_angle);
+		float sinAngle = std::sin(_angle);
+		float cosAngle = std::cos(_angle);
 
 		matrix4.m_matrix[1][1] = 1.0f;
 		matrix4.m_matrix[3][3] = 1.0f;
@@ -225,8 +447,8 @@ namespace LibMath
 	{
 		Matrix4 matrix4;
 
-		float sinAngle = sinf(_angle);
-		float cosAngle = cosf(_angle);
+		float sinAngle = std::sin(_angle);
+		float cosAngle = std::cos(_angle);
 
 		if (_isRowMajor)
 		{
@@ -297,7 +519,7 @@ namespace LibMath
 		const float pi = 3.14f;
 		_fovy = _fovy * (pi / 180.0f);
 
-		float tanAngle = tanf(_fovy / 2.0f);
+		float tanAngle = std::tan(_fovy / 2.0f);
 
 		projectionMatrix.m_matrix[0][0] = 1.0f / (_aspect * tanAngle);
 		projectionMatrix.m_matrix[1][1] = 1.0f / tanAngle;
@@ -392,29 +614,9 @@ namespace LibMath
 	/// Multiply two matrices together & return the result
 	Matrix4		Matrix4::operator*(const Matrix4& _other) const
 	{
-		// Create a null 4x4 matrix
-		float initValues[4][4] =
-		{
-			{0.0f, 0.0f, 0.0f, 0.0f},
-			{0.0f, 0.0f, 0.0f, 0.0f},
-			{0.0f, 0.0f, 0.0f, 0.0f},
-			{0.0f, 0.0f, 0.0f, 0.0f}
-		};
+		Matrix4 result;
 
-		LibMath::Matrix4 result = LibMath::Matrix4(initValues);
-
-		// Iterate through matrix to set the result matrix equal to the result of the 2 matrices multiplied
-		for (int i = 0; i < 4; ++i)
-		{
-			for (int j = 0; j < 4; ++j)
-			{
-				for (int k = 0; k < 4; ++k)
-				{
-					// Add the value obtained from multiplying the 2 matrices row * column
-					result.m_matrix[i][j] += this->m_matrix[i][k] * _other.m_matrix[k][j];
-				}
-			}
-		}
+		multiply(this, &_other, &result, 1);
 
 		return result;
 	}
@@ -510,6 +712,12 @@ namespace LibMath
 		return result;
 	}
 
+	/// Multiply _count pairs of matrices (_result[i] = _lhs[i] * _rhs[i]) with the active instruction set
+	void	multiply(const Matrix4* _lhs, const Matrix4* _rhs, Matrix4* _result, size_t _count)
+	{
+		multiplyKernel(activeInstructionSet())(_lhs, _rhs, _result, _count);
+	}
+
 #pragma endregion
 
 
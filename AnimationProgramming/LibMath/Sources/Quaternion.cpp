@@ -2,6 +2,7 @@
 
 #include "Quaternion.h"
 #include "Trigonometry.h"
+#include "SIMD.h"
 
 #pragma endregion
 
@@ -11,8 +12,168 @@
 
 #pragma endregion
 
+#if LIBMATH_X86
+#include <immintrin.h>
+#endif
+
 namespace LibMath
 {
+#pragma region Rotation kernels
+
+	namespace
+	{
+		/// Signature shared by every batched rotation kernel
+		typedef void (*RotateKernel)(QuaternionArrays const&, Vector3Arrays const&, Vector3Arrays const&, size_t, size_t);
+
+		/// Rotate the vectors from _begin to _end one at a time
+		void		rotateScalar(QuaternionArrays const& _rotations, Vector3Arrays const& _vectors, 
+								 Vector3Arrays const& _result, size_t _begin, size_t _end)
+		{
+			for (size_t i = _begin; i < _end; ++i)
+			{
+				Vector3 result = rotate(Quaternion(_rotations.m_a[i], _rotations.m_b[i], _rotations.m_c[i], _rotations.m_d[i]),
+										Vector3(_vectors.m_x[i], _vectors.m_y[i], _vectors.m_z[i]));
+
+				_result.m_x[i] = result.m_x;
+				_result.m_y[i] = result.m_y;
+				_result.m_z[i] = result.m_z;
+			}
+		}
+
+#if LIBMATH_X86
+		/// Rotate four vectors at a time with 128 bits registers
+		void		rotateSSE(QuaternionArrays const& _rotations, Vector3Arrays const& _vectors, 
+							  Vector3Arrays const& _result, size_t _begin, size_t _end)
+		{
+			size_t i = _begin;
+
+			for (; i + 4 <= _end; i += 4)
+			{
+				__m128 w = _mm_loadu_ps(_rotations.m_a + i);
+				__m128 qx = _mm_loadu_ps(_rotations.m_b + i);
+				__m128 qy = _mm_loadu_ps(_rotations.m_c + i);
+				__m128 qz = _mm_loadu_ps(_rotations.m_d + i);
+
+				__m128 x = _mm_loadu_ps(_vectors.m_x + i);
+				__m128 y = _mm_loadu_ps(_vectors.m_y + i);
+				__m128 z = _mm_loadu_ps(_vectors.m_z + i);
+
+				// t = 2 * cross(q.xyz, v)
+				__m128 two = _mm_set1_ps(2.f);
+				__m128 tx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y)));
+				__m128 ty = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z)));
+				__m128 tz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x)));
+
+				// v + w * t + cross(q.xyz, t)
+				x = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(w, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+				y = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(w, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+				z = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(w, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+
+				_mm_storeu_ps(_result.m_x + i, x);
+				_mm_storeu_ps(_result.m_y + i, y);
+				_mm_storeu_ps(_result.m_z + i, z);
+			}
+
+			rotateScalar(_rotations, _vectors, _result, i, _end);
+		}
+
+		/// Rotate eight vectors at a time with 256 bits registers
+		LIBMATH_TARGET_AVX
+		void		rotateAVX(QuaternionArrays const& _rotations, Vector3Arrays const& _vectors, 
+							  Vector3Arrays const& _result, size_t _begin, size_t _end)
+		{
+			size_t i = _begin;
+
+			for (; i + 8 <= _end; i += 8)
+			{
+				__m256 w = _mm256_loadu_ps(_rotations.m_a + i);
+				__m256 qx = _mm256_loadu_ps(_rotations.m_b + i);
+				__m256 qy = _mm256_loadu_ps(_rotations.m_c + i);
+				__m256 qz = _mm256_loadu_ps(_rotations.m_d + i);
+
+				__m256 x = _mm256_loadu_ps(_vectors.m_x + i);
+				__m256 y = _mm256_loadu_ps(_vectors.m_y + i);
+				__m256 z = _mm256_loadu_ps(_vectors.m_z + i);
+
+				__m256 two = _mm256_set1_ps(2.f);
+				__m256 tx = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(qy, z), _mm256_mul_ps(qz, y)));
+				__m256 ty = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(qz, x), _mm256_mul_ps(qx, z)));
+				__m256 tz = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(qx, y), _mm256_mul_ps(qy, x)));
+
+				x = _mm256_add_ps(_mm256_add_ps(x, _mm256_mul_ps(w, tx)), 
+								  _mm256_sub_ps(_mm256_mul_ps(qy, tz), _mm256_mul_ps(qz, ty)));
+				y = _mm256_add_ps(_mm256_add_ps(y, _mm256_mul_ps(w, ty)), 
+								  _mm256_sub_ps(_mm256_mul_ps(qz, tx), _mm256_mul_ps(qx, tz)));
+				z = _mm256_add_ps(_mm256_add_ps(z, _mm256_mul_ps(w, tz)), 
+								  _mm256_sub_ps(_mm256_mul_ps(qx, ty), _mm256_mul_ps(qy, tx)));
+
+				_mm256_storeu_ps(_result.m_x + i, x);
+				_mm256_storeu_ps(_result.m_y + i, y);
+				_mm256_storeu_ps(_result.m_z + i, z);
+			}
+
+			rotateScalar(_rotations, _vectors, _result, i, _end);
+		}
+
+		/// Rotate eight vectors at a time with fused multiply-add
+		LIBMATH_TARGET_AVX2
+		void		rotateAVX2(QuaternionArrays const& _rotations, Vector3Arrays const& _vectors, 
+							   Vector3Arrays const& _result, size_t _begin, size_t _end)
+		{
+			size_t i = _begin;
+
+			for (; i + 8 <= _end; i += 8)
+			{
+				__m256 w = _mm256_loadu_ps(_rotations.m_a + i);
+				__m256 qx = _mm256_loadu_ps(_rotations.m_b + i);
+				__m256 qy = _mm256_loadu_ps(_rotations.m_c + i);
+				__m256 qz = _mm256_loadu_ps(_rotations.m_d + i);
+
+				__m256 x = _mm256_loadu_ps(_vectors.m_x + i);
+				__m256 y = _mm256_loadu_ps(_vectors.m_y + i);
+				__m256 z = _mm256_loadu_ps(_vectors.m_z + i);
+
+				__m256 two = _mm256_set1_ps(2.f);
+				__m256 tx = _mm256_mul_ps(two, _mm256_fmsub_ps(qy, z, _mm256_mul_ps(qz, y)));
+				__m256 ty = _mm256_mul_ps(two, _mm256_fmsub_ps(qz, x, _mm256_mul_ps(qx, z)));
+				__m256 tz = _mm256_mul_ps(two, _mm256_fmsub_ps(qx, y, _mm256_mul_ps(qy, x)));
+
+				x = _mm256_add_ps(_mm256_fmadd_ps(w, tx, x), _mm256_fmsub_ps(qy, tz, _mm256_mul_ps(qz, ty)));
+				y = _mm256_add_ps(_mm256_fmadd_ps(w, ty, y), _mm256_fmsub_ps(qz, tx, _mm256_mul_ps(qx, tz)));
+				z = _mm256_add_ps(_mm256_fmadd_ps(w, tz, z), _mm256_fmsub_ps(qx, ty, _mm256_mul_ps(qy, tx)));
+
+				_mm256_storeu_ps(_result.m_x + i, x);
+				_mm256_storeu_ps(_result.m_y + i, y);
+				_mm256_storeu_ps(_result.m_z + i, z);
+			}
+
+			rotateScalar(_rotations, _vectors, _result, i, _end);
+		}
+#endif
+
+		/// Return the rotation kernel matching an instruction set
+		RotateKernel	rotateKernel(InstructionSet _instructionSet)
+		{
+#if LIBMATH_X86
+			switch (_instructionSet)
+			{
+			case InstructionSet::AVX2:
+				return rotateAVX2;
+			case InstructionSet::AVX:
+				return rotateAVX;
+			case InstructionSet::SSE:
+				return rotateSSE;
+			default:
+				return rotateScalar;
+			}
+#else
+			return rotateScalar;
+#endif
+		}
+	}
+
+#pragma endregion
+
 	Quaternion operator-(Quaternion const& _other)
 	{
 		return Quaternion(_other.m_a, -_other.m_b, -_other.m_c, -_other.m_d);
@@ -48,10 +209,7 @@ namespace LibMath
 	}
 	Vector3				operator*(Vector3 const& _lhs, Quaternion const& _rhs)
 	{
-		Quaternion pos = Quaternion(0.f, _lhs.m_x, _lhs.m_y, _lhs.m_z);
-		Quaternion result = (_rhs * pos) * LibMath::conjugate(_rhs);
-
-		return Vector3(result.m_b, result.m_c, result.m_d);
+		return rotate(_rhs, _lhs);
 	}
 	Quaternion operator/(Quaternion _lhs, float _scalar)
 	{
@@ -143,10 +301,10 @@ namespace LibMath
 
 		if (cosHalfTheta < 0.9999f)
 		{
-			const float omega = acosf(cosHalfTheta);
-			const float invSin = 1.f / sinf(omega);
-			scale0 = sinf(scale0 * omega) * invSin;
-			scale1 = sinf(scale1 * omega) * invSin;
+			const float omega = std::acos(cosHalfTheta);
+			const float invSin = 1.f / std::sin(omega);
+			scale0 = std::sin(scale0 * omega) * invSin;
+			scale1 = std::sin(scale1 * omega) * invSin;
 		}
 
 		return Quaternion(
@@ -156,6 +314,80 @@ namespace LibMath
 			scale0 * _quat1.m_d + scale1 * _quat2.m_d);
 	}
 
+	/// Normalized linear interpolation on the shortest path
+	Quaternion nlerp(Quaternion const& _quat1, Quaternion const& _quat2, float _scalar)
+	{
+		/*Flip the second rotation when the quaternions are in opposite hemispheres*/
+		const float scale0 = 1.f - _scalar;
+		const float scale1 = _scalar * floatSelect(quaternionDotProduct(_quat1, _quat2));
+
+		Quaternion result(
+			scale0 * _quat1.m_a + scale1 * _quat2.m_a,
+			scale0 * _quat1.m_b + scale1 * _quat2.m_b,
+			scale0 * _quat1.m_c + scale1 * _quat2.m_c,
+			scale0 * _quat1.m_d + scale1 * _quat2.m_d);
+
+		const float invLength = 1.f / std::sqrt(quaternionMagnitudeSquared(result));
+
+		return Quaternion(result.m_a * invLength, result.m_b * invLength, result.m_c * invLength, result.m_d * invLength);
+	}
+
+	/// Nlerp with the parameter corrected by a polynomial fitted on slerp (Kapoulkine, "Approximating slerp")
+	Quaternion approximateSlerp(Quaternion const& _quat1, Quaternion const& _quat2, float _scalar)
+	{
+		const float dot = quaternionDotProduct(_quat1, _quat2);
+		const float cosHalfTheta = std::fabs(dot);
+
+		const float a = 1.0904f + cosHalfTheta * (-3.2452f + cosHalfTheta * (3.55645f - cosHalfTheta * 1.43519f));
+		const float b = 0.848013f + cosHalfTheta * (-1.06021f + cosHalfTheta * 0.215638f);
+		const float k = a * (_scalar - 0.5f) * (_scalar - 0.5f) + b;
+
+		const float correctedScalar = _scalar + _scalar * (_scalar - 0.5f) * (_scalar - 1.f) * k;
+
+		/*Same as nlerp, without computing the dot product twice*/
+		const float scale0 = 1.f - correctedScalar;
+		const float scale1 = correctedScalar * floatSelect(dot);
+
+		Quaternion result(
+			scale0 * _quat1.m_a + scale1 * _quat2.m_a,
+			scale0 * _quat1.m_b + scale1 * _quat2.m_b,
+			scale0 * _quat1.m_c + scale1 * _quat2.m_c,
+			scale0 * _quat1.m_d + scale1 * _quat2.m_d);
+
+		const float invLength = 1.f / std::sqrt(quaternionMagnitudeSquared(result));
+
+		return Quaternion(result.m_a * invLength, result.m_b * invLength, result.m_c * invLength, result.m_d * invLength);
+	}
+
+	/// Interpolate two rotations with the selected interpolation
+	Quaternion interpolateRotation(Quaternion const& _quat1, Quaternion const& _quat2, float _scalar, 
+								   RotationInterpolation _interpolation)
+	{
+		switch (_interpolation)
+		{
+		case RotationInterpolation::Nlerp:
+			return nlerp(_quat1, _quat2, _scalar);
+		case RotationInterpolation::ApproximateSlerp:
+			return approximateSlerp(_quat1, _quat2, _scalar);
+		default:
+			return slerp(_quat1, _quat2, _scalar);
+		}
+	}
+
+	/// Return the name of a rotation interpolation
+	const char* rotationInterpolationName(RotationInterpolation _interpolation)
+	{
+		switch (_interpolation)
+		{
+		case RotationInterpolation::Nlerp:
+			return "nlerp";
+		case RotationInterpolation::ApproximateSlerp:
+			return "approximate slerp";
+		default:
+			return "slerp";
+		}
+	}
+
 	Vector4 rotatePoint(Quaternion const& _quat, Vector4 const& _vec)
 	{
 		Quaternion result = _quat * Quaternion{ _vec.m_x, _vec.m_y, _vec.m_z, _vec.m_w } * conjugate(_quat);
@@ -163,23 +395,50 @@ namespace LibMath
 		return Vector4(result.m_a, result.m_b, result.m_c, result.m_d);
 	}
 
+	/// Rotate a vector by a unit quaternion with two cross products instead of two quaternion products
+	Vector3 rotate(Quaternion const& _rotation, Vector3 const& _vector)
+	{
+		/*t = 2 * cross(q.xyz, v)*/
+		const float tx = 2.f * (_rotation.m_c * _vector.m_z - _rotation.m_d * _vector.m_y);
+		const float ty = 2.f * (_rotation.m_d * _vector.m_x - _rotation.m_b * _vector.m_z);
+		const float tz = 2.f * (_rotation.m_b * _vector.m_y - _rotation.m_c * _vector.m_x);
+
+		/*v + w * t + cross(q.xyz, t)*/
+		return Vector3(
+			_vector.m_x + _rotation.m_a * tx + _rotation.m_c * tz - _rotation.m_d * ty,
+			_vector.m_y + _rotation.m_a * ty + _rotation.m_d * tx - _rotation.m_b * tz,
+			_vector.m_z + _rotation.m_a * tz + _rotation.m_b * ty - _rotation.m_c * tx);
+	}
+
+	/// Rotate _count vectors by _count unit quaternions with the active instruction set, the result can alias the vectors
+	void rotate(QuaternionArrays const& _rotations, Vector3Arrays const& _vectors, Vector3Arrays const& _result, 
+				size_t _count)
+	{
+		rotateKernel(activeInstructionSet())(_rotations, _vectors, _result, 0, _count);
+	}
+
 	Matrix4 toMatrix4(Quaternion const& _other)
 	{
+		const float aa = _other.m_a * _other.m_a;
+		const float bb = _other.m_b * _other.m_b;
+		const float cc = _other.m_c * _other.m_c;
+		const float dd = _other.m_d * _other.m_d;
+
 		Matrix4 mat;
 
-		mat.m_matrix[0][0] = power(_other.m_a, 2) + power(_other.m_b, 2) - power(_other.m_c, 2) - power(_other.m_d, 2);
+		mat.m_matrix[0][0] = aa + bb - cc - dd;
 		mat.m_matrix[0][1] = 2 * (_other.m_b * _other.m_c) + 2 * (_other.m_a * _other.m_d);
 		mat.m_matrix[0][2] = 2 * (_other.m_b * _other.m_d) - 2 * (_other.m_a * _other.m_c);
 		mat.m_matrix[0][3] = 0.f;
 
 		mat.m_matrix[1][0] = 2 * (_other.m_b * _other.m_c) - 2 * (_other.m_a * _other.m_d);
-		mat.m_matrix[1][1] = power(_other.m_a, 2) - power(_other.m_b, 2) + power(_other.m_c, 2) - power(_other.m_d, 2);
+		mat.m_matrix[1][1] = aa - bb + cc - dd;
 		mat.m_matrix[1][2] = 2 * (_other.m_c * _other.m_d) + 2 * (_other.m_a * _other.m_b);
 		mat.m_matrix[1][3] = 0.f;
 
 		mat.m_matrix[2][0] = 2 * (_other.m_b * _other.m_d) + 2 * (_other.m_a * _other.m_c);
 		mat.m_matrix[2][1] = 2 * (_other.m_c * _other.m_d) - 2 * (_other.m_a * _other.m_b);
-		mat.m_matrix[2][2] = power(_other.m_a, 2) - power(_other.m_b, 2) - power(_other.m_c, 2) + power(_other.m_d, 2);
+		mat.m_matrix[2][2] = aa - bb - cc + dd;
 		mat.m_matrix[2][3] = 0.f;
 
 		mat.m_matrix[3][0] = 0.f;
@@ -0,0 +1,122 @@
+/// Header
+#include "SIMD.h"
+
+#if LIBMATH_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace LibMath
+{
+	namespace
+	{
+#if LIBMATH_X86
+		/// Fill the registers returned by the cpuid instruction for a leaf
+		void	cpuid(int _registers[4], int _leaf)
+		{
+#if defined(_MSC_VER)
+			__cpuidex(_registers, _leaf, 0);
+#else
+			unsigned int eax, ebx, ecx, edx;
+			__cpuid_count(_leaf, 0, eax, ebx, ecx, edx);
+			_registers[0] = int(eax);
+			_registers[1] = int(ebx);
+			_registers[2] = int(ecx);
+			_registers[3] = int(edx);
+#endif
+		}
+
+		/// Return the extended control register telling which register states the OS saves
+		unsigned long long	xgetbv()
+		{
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			unsigned int eax, edx;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+		}
+#endif
+
+		/// Instruction set used by the kernels, detected on first use
+		InstructionSet&	currentInstructionSet()
+		{
+			static InstructionSet instructionSet = detectInstructionSet();
+
+			return instructionSet;
+		}
+	}
+
+	/// Return the newest instruction set supported by the processor and the operating system
+	InstructionSet	detectInstructionSet()
+	{
+#if LIBMATH_X86
+		int registers[4];
+
+		cpuid(registers, 0);
+		int leafCount = registers[0];
+
+		cpuid(registers, 1);
+
+		bool hasSSE2	= (registers[3] & (1 << 26)) != 0;
+		bool hasOSXSave = (registers[2] & (1 << 27)) != 0;
+		bool hasAVX		= (registers[2] & (1 << 28)) != 0;
+		bool hasFMA		= (registers[2] & (1 << 12)) != 0;
+
+		if (!hasSSE2)
+			return InstructionSet::Scalar;
+
+		// AVX also needs the OS to save the ymm registers on context switch
+		if (!hasOSXSave || !hasAVX || (xgetbv() & 0x6) != 0x6)
+			return InstructionSet::SSE;
+
+		if (leafCount >= 7)
+		{
+			cpuid(registers, 7);
+
+			bool hasAVX2 = (registers[1] & (1 << 5)) != 0;
+
+			if (hasAVX2 && hasFMA)
+				return InstructionSet::AVX2;
+		}
+
+		return InstructionSet::AVX;
+#else
+		return InstructionSet::Scalar;
+#endif
+	}
+	/// Return the instruction set currently used by the vectorized kernels
+	InstructionSet	activeInstructionSet()
+	{
+		return currentInstructionSet();
+	}
+	/// Force the kernels to an instruction set (clamped to the supported one) and return the one selected
+	InstructionSet	selectInstructionSet(InstructionSet _instructionSet)
+	{
+		InstructionSet supported = detectInstructionSet();
+
+		currentInstructionSet() = _instructionSet > supported ? supported : _instructionSet;
+
+		return currentInstructionSet();
+	}
+	/// Return the name of an instruction set
+	const char*		instructionSetName(InstructionSet _instructionSet)
+	{
+		switch (_instructionSet)
+		{
+		case InstructionSet::SSE:
+			return "SSE";
+		case InstructionSet::AVX:
+			return "AVX";
+		case InstructionSet::AVX2:
+			return "AVX2";
+		default:
+			return "Scalar";
+		}
+	}
+
+} // !Namespace LibMath
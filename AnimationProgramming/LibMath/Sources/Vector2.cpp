@@ -1,6 +1,8 @@
 /// Header
 #include "Vector/Vector2.h"
 
+#include <cmath>
+
 namespace LibMath
 {
 #pragma region Constructor
@@ -61,7 +63,7 @@ namespace LibMath
 	Radian Vector2::angleFrom(Vector3 const& other) const
 	{
 		float dot = this->dotProduct(other);
-		float radian = std::acosf(dot / (this->magnitude() * other.magnitude()));
+		float radian = std::acos(dot / (this->magnitude() * other.magnitude()));
 
 		return Radian(radian);
 	}
@@ -73,14 +75,14 @@ namespace LibMath
 	/// Calcul the distance between two vector
 	float			Vector2::distanceFrom(const Vector2& other) const
 	{
-		return float(std::sqrtf(std::powf(other.m_x - this->m_x, 2) +
-			std::powf(other.m_y - this->m_y, 2)));
+		return float(std::sqrt(std::pow(other.m_x - this->m_x, 2) +
+			std::pow(other.m_y - this->m_y, 2)));
 	}
 	/// Calcul the square distance between two vector
 	float			Vector2::squaredDistanceFrom(const Vector2& other) const
 	{
-		return float(std::powf(other.m_x - this->m_x, 2) +
-			std::powf(other.m_y - this->m_y, 2));
+		return float(std::pow(other.m_x - this->m_x, 2) +
+			std::pow(other.m_y - this->m_y, 2));
 	}
 	/// Calcul the dot product between two vector
 	float			Vector2::dotProduct(const Vector2& other) const
@@ -90,14 +92,14 @@ namespace LibMath
 	/// Calcul the magnitude of this vector
 	float			Vector2::magnitude(void) const///Calcul the magnitude of a vector 2D
 	{
-		return float(std::sqrt(std::powf(this->m_x, 2) +
-			std::powf(this->m_y, 2)));
+		return float(std::sqrt(std::pow(this->m_x, 2) +
+			std::pow(this->m_y, 2)));
 	}
 	/// Calcul the square magnitude of this vector
 	float			Vector2::squareMagnitude(void) const///Calcul the square magnitude of a vector 2D
 	{
-		return float(std::powf(this->m_x, 2) +
-			std::powf(this->m_y, 2));
+		return float(std::pow(this->m_x, 2) +
+			std::pow(this->m_y, 2));
 	}
 	///Check if the vector 2D is unitary or not
 	bool			Vector2::isUnit(void) const 
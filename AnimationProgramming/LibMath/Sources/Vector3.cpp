@@ -1,6 +1,8 @@
 ///Header
 #include "Vector/Vector3.h"
 
+#include <cmath>
+
 namespace LibMath
 {
 #pragma region Constructor
@@ -73,35 +75,35 @@ namespace LibMath
 	Radian				Vector3::angleFrom(Vector3 const& other) const
 	{
 		float dot = this->dot(other);
-		float radian = std::acosf(dot / (this->magnitude() * other.magnitude()));
+		float radian = std::acos(dot / (this->magnitude() * other.magnitude()));
 
 		return Radian(radian);
 	}
 	/// Function to calcul the distance between two vector
 	float				Vector3::distanceFrom(Vector3 const& other) const
 	{
-		return float(std::sqrt(std::powf(other.m_x - this->m_x, 2) +
-							   std::powf(other.m_y - this->m_y, 2) +
-							   std::powf(other.m_z - this->m_z, 2)));
+		return float(std::sqrt(std::pow(other.m_x - this->m_x, 2) +
+							   std::pow(other.m_y - this->m_y, 2) +
+							   std::pow(other.m_z - this->m_z, 2)));
 	}
 	/// Function to calcul the square distance between two vector
 	float				Vector3::distanceSquaredFrom(Vector3 const& other) const
 	{
-		return float(std::powf(other.m_x - this->m_x, 2) +
-					 std::powf(other.m_y - this->m_y, 2) +
-					 std::powf(other.m_z - this->m_z, 2));
+		return float(std::pow(other.m_x - this->m_x, 2) +
+					 std::pow(other.m_y - this->m_y, 2) +
+					 std::pow(other.m_z - this->m_z, 2));
 	}
 	/// Function to calcul the distance between two vector on the x and y axis
 	float				Vector3::distance2DFrom(Vector3 const& other) const
 	{
-		return float(std::sqrt(std::powf(other.m_x - this->m_x, 2) +
-							   std::powf(other.m_y - this->m_y, 2)));
+		return float(std::sqrt(std::pow(other.m_x - this->m_x, 2) +
+							   std::pow(other.m_y - this->m_y, 2)));
 	}
 	/// Function to calcul the sqaure distance between two vector on the x and y axis
 	float				Vector3::distance2DSquaredFrom(Vector3 const& other) const
 	{
-		return float(std::powf(other.m_x - this->m_x, 2) +
-					 std::powf(other.m_y - this->m_y, 2));
+		return float(std::pow(other.m_x - this->m_x, 2) +
+					 std::pow(other.m_y - this->m_y, 2));
 	}
 	/// Function to calcul the dot product between two vector
 	float				Vector3::dot(Vector3 const& other) const
@@ -113,16 +115,16 @@ namespace LibMath
 	/// Function to calcul the magnitude of this vector
 	float				Vector3::magnitude(void) const
 	{
-		return float(std::sqrtf(std::powf(this->m_x, 2) +
-			std::powf(this->m_y, 2) +
-			std::powf(this->m_z, 2)));
+		return float(std::sqrt(std::pow(this->m_x, 2) +
+			std::pow(this->m_y, 2) +
+			std::pow(this->m_z, 2)));
 	}
 	/// Functioon to calcul the sqaure magnituude of this vector
 	float				Vector3::magnitudeSquared(void) const
 	{
-		return float(std::powf(this->m_x, 2) +
-			std::powf(this->m_y, 2) +
-			std::powf(this->m_z, 2));
+		return float(std::pow(this->m_x, 2) +
+			std::pow(this->m_y, 2) +
+			std::pow(this->m_z, 2));
 	}
 
 	/// Check if the magnitude of this vector is greater than the other vector
@@ -189,18 +191,18 @@ namespace LibMath
 	/// Calcul the rotation of the vector
 	Vector3&			Vector3::rotate(Radian z, Radian x, Radian y)
 	{
-		float x_vertex = this->m_x * std::cosf(z.radian(false)) - this->m_y * std::sinf(z.radian(false));
-		float y_vertex = -this->m_x * std::sinf(z.radian(false)) + this->m_y * std::cosf(z.radian(false));
+		float x_vertex = this->m_x * std::cos(z.radian(false)) - this->m_y * std::sin(z.radian(false));
+		float y_vertex = -this->m_x * std::sin(z.radian(false)) + this->m_y * std::cos(z.radian(false));
 
 		this->m_x = x_vertex, this->m_y = y_vertex;
 
-		y_vertex = this->m_y * std::cosf(x.radian(false)) - this->m_z * std::sinf(x.radian(false));
-		float z_vertex = this->m_y * std::sinf(x.radian(false)) + this->m_z * std::cosf(x.radian(false));
+		y_vertex = this->m_y * std::cos(x.radian(false)) - this->m_z * std::sin(x.radian(false));
+		float z_vertex = this->m_y * std::sin(x.radian(false)) + this->m_z * std::cos(x.radian(false));
 
 		this->m_y = y_vertex, this->m_z = z_vertex;
 
-		x_vertex = this->m_x * std::cosf(y.radian(false)) + this->m_z * std::sinf(y.radian(false));
-		z_vertex = -this->m_x * -std::sinf(y.radian(false)) + this->m_z * std::cosf(y.radian(false));
+		x_vertex = this->m_x * std::cos(y.radian(false)) + this->m_z * std::sin(y.radian(false));
+		z_vertex = -this->m_x * -std::sin(y.radian(false)) + this->m_z * std::cos(y.radian(false));
 
 		this->m_x = x_vertex, this->m_z = z_vertex;
 
@@ -1,6 +1,8 @@
 ///Header
 #include "Vector/Vector4.h"
 
+#include <cmath>
+
 namespace LibMath
 {
 
@@ -46,37 +48,37 @@ namespace LibMath
 	Radian			Vector4::angleFrom(Vector4 const& other) const
 	{
 		float dot = this->dot(other);
-		float radian = std::acosf(dot / (this->magnitude() * other.magnitude()));
+		float radian = std::acos(dot / (this->magnitude() * other.magnitude()));
 
 		return Radian(radian);
 	}
 	/// Function to calcul the distance between two points
 	float			Vector4::distanceFrom(Vector4 const& other) const
 	{
-		return float(std::sqrtf(std::powf(other.m_x - this->m_x, 2) +
-								std::powf(other.m_y - this->m_y, 2) +
-								std::powf(other.m_z - this->m_z, 2) +
-								std::powf(other.m_w - this->m_w, 2)));
+		return float(std::sqrt(std::pow(other.m_x - this->m_x, 2) +
+								std::pow(other.m_y - this->m_y, 2) +
+								std::pow(other.m_z - this->m_z, 2) +
+								std::pow(other.m_w - this->m_w, 2)));
 	}
 	/// Function to return the square of the distance between two points
 	float			Vector4::distanceSquaredFrom(Vector4 const& other) const
 	{
-		return float(std::powf(other.m_x - this->m_x, 2) +
-					 std::powf(other.m_y - this->m_y, 2) +
-					 std::powf(other.m_z - this->m_z, 2) +
-					 std::powf(other.m_w - this->m_w, 2));
+		return float(std::pow(other.m_x - this->m_x, 2) +
+					 std::pow(other.m_y - this->m_y, 2) +
+					 std::pow(other.m_z - this->m_z, 2) +
+					 std::pow(other.m_w - this->m_w, 2));
 	}
 	/// Function to calcul the distance between 2 points on the x and y axis
 	float			Vector4::distance2DFrom(Vector4 const& other) const
 	{
-		return float(std::sqrt(std::powf(other.m_x - this->m_x, 2) +
-							   std::powf(other.m_y - this->m_y, 2)));
+		return float(std::sqrt(std::pow(other.m_x - this->m_x, 2) +
+							   std::pow(other.m_y - this->m_y, 2)));
 	}
 	/// Function to calcul the square of the distance between two points on the x and y axis
 	float			Vector4::distance2DSquaredFrom(Vector4 const& other) const
 	{
-		return float(std::powf(other.m_x - this->m_x, 2) +
-					 std::powf(other.m_y - this->m_y, 2));
+		return float(std::pow(other.m_x - this->m_x, 2) +
+					 std::pow(other.m_y - this->m_y, 2));
 	}
 	/// Calcul the dot product between two vector
 	float			Vector4::dot(Vector4 const& other) const
@@ -114,18 +116,18 @@ namespace LibMath
 	/// Calcul the magnitude of a vector
 	float			Vector4::magnitude(void) const
 	{
-		return float(std::sqrtf(std::powf(this->m_x, 2) +
-								std::powf(this->m_y, 2) +
-								std::powf(this->m_z, 2) +
-								std::powf(this->m_w, 2)));
+		return float(std::sqrt(std::pow(this->m_x, 2) +
+								std::pow(this->m_y, 2) +
+								std::pow(this->m_z, 2) +
+								std::pow(this->m_w, 2)));
 	}
 	/// Calcul the squared magnitude of a vector
 	float			Vector4::magnitudeSquared(void) const
 	{
-		return float(std::powf(this->m_x, 2) +
-					 std::powf(this->m_y, 2) +
-					 std::powf(this->m_z, 2) +
-					 std::powf(this->m_w, 2));
+		return float(std::pow(this->m_x, 2) +
+					 std::pow(this->m_y, 2) +
+					 std::pow(this->m_z, 2) +
+					 std::pow(this->m_w, 2));
 	}
 	/// Normalize the vector
 	Vector4&		Vector4::normalize(void)
@@ -1,6 +1,7 @@
 #pragma region Simulation
 
 #include "MySimulation.h"
+#include "ResourceFile.h"
 #include "Engine.h"
 
 #pragma endregion
@@ -8,7 +9,11 @@
 #pragma region Standard
 
 #include <stdio.h>
+#include <algorithm>
+#include <cmath>
 #include <cassert>
+#include <cstring>
+#include <iostream>
 
 #pragma endregion
 
@@ -25,27 +30,210 @@ void				MySimulation::initMembers()
 	/*Get the animation key count*/
 	m_walkAnimation.m_frameCount = GetAnimKeyCount("ThirdPersonWalk.anim");
 	m_runAnimation.m_frameCount = GetAnimKeyCount("ThirdPersonRun.anim");
-
-	m_walkAnimation.m_isActivated = true;
-
-	m_currentAnimation = &m_walkAnimation;
-	m_nextAnimation = &m_runAnimation;
 }
 
 /// Initialize the scale to {1.f, 1.f, 1.f}
-void				MySimulation::initScale(std::vector<Bone>& _skeleton, int _animKeyCount)
+void				MySimulation::initScale(Animation& _animation)
 {
 	for (int index = 0; index < m_boneCount; ++index)
 	{
-		_skeleton[index].m_localTransform.m_scale = { 1.f, 1.f, 1.f };
-		_skeleton[index].m_worldTransform.m_scale = { 1.f, 1.f, 1.f };
+		_animation.m_skeletonAnim[index].m_localTransform.m_scale = { 1.f, 1.f, 1.f };
+		_animation.m_skeletonAnim[index].m_worldTransform.m_scale = { 1.f, 1.f, 1.f };
+	}
+
+	/*The keys still have one track per bone, the clip is classified after*/
+	for (size_t j = 0; j < _animation.m_clip.m_keyCount; ++j)
+	{
+		for (size_t i = 0; i < m_boneCount; ++i)
+		{
+			Transform key = _animation.m_clip.getKey(j, i);
+			key.m_scale = { 1.f, 1.f, 1.f };
+
+			_animation.m_clip.setKey(j, i, key);
+		}
+	}
+
+	for (Transform& worldTransform : _animation.m_worldTransforms)
+	{
+		worldTransform.m_scale = { 1.f, 1.f, 1.f };
+	}
+}
+
+/// Compute the bind pose world transforms once and build the skeleton shared by every animation
+void				MySimulation::initSkeleton()
+{
+	/*Both animations share the same skeleton so the bind pose is computed once*/
+	std::vector<Bone>& skeleton = m_walkAnimation.m_skeletonAnim;
+
+	std::vector<Transform> localBindPose(m_boneCount);
+	std::vector<int> parentIndices(m_boneCount);
+
+	for (int i = 0; i < m_boneCount; ++i)
+	{
+		int ancestorIndex = skeleton[i].m_parentIndex;
+
+		if (ancestorIndex == -1)
+		{
+			/*Init root bind position/rotation*/
+			skeleton[i].m_worldTransform = skeleton[i].m_localTransform;
+		}
+		else
+		{
+			/*Combine the local bind transform with the parent bind transform*/
+			skeleton[i].m_worldTransform = skeleton[i].m_localTransform * skeleton[ancestorIndex].m_worldTransform;
+		}
+
+		m_runAnimation.m_skeletonAnim[i].m_worldTransform = skeleton[i].m_worldTransform;
+
+		localBindPose[i] = skeleton[i].m_localTransform;
+		parentIndices[i] = ancestorIndex;
+	}
+
+	/*Cache the inverse of the bind transforms to place the vertices in bone space*/
+	m_skeleton.build(localBindPose, parentIndices);
+
+	/*The bind pose never changes, step 1 composes it on its first frame only*/
+	m_bindPoseHierarchy.initialize(parentIndices, localBindPose);
+
+	for (Animation* animation : { &m_walkAnimation, &m_runAnimation })
+	{
+		animation->m_currentKey.m_evaluator.initialize(parentIndices, localBindPose);
+	}
+}
+
+/// Create the characters of the crowd and the worker threads that update them
+void				MySimulation::initCrowd()
+{
+	if (!m_threadPool)
+	{
+		m_threadPool.reset(new ThreadPool());
+	}
+
+	m_crowd.initialize(m_skeleton, { &m_walkAnimation.m_clip, &m_runAnimation.m_clip }, m_crowdSize, m_paletteFormat,
+					   &m_poseCache);
+
+	initFrameGraph();
+}
+
+/// Build the tasks of a crowd frame : evaluation on the pool, submission and drawing on the engine thread
+void				MySimulation::initFrameGraph()
+{
+	std::vector<size_t> poseTasks;
+	std::vector<size_t> paletteTasks;
+
+	m_frameGraph.clear();
+	m_crowd.addFrameTasks(m_frameGraph, poseTasks, paletteTasks);
+
+	/*The engine skins a single mesh, the first character drives it*/
+	size_t submitTask = m_frameGraph.addTask([this]()
+	{
+		SetSkinningPose(m_crowd.m_instances[0].paletteData(), paletteSubmitCount(m_paletteFormat, m_boneCount));
+	}, TaskThread::Caller);
+
+	m_frameGraph.addDependency(paletteTasks[0], submitTask);
+
+	/*The other characters are drawn as skeletons, one task per group in the order of the characters*/
+	size_t drawnCount = m_crowd.m_instances.size() < m_crowdDrawCount ? m_crowd.m_instances.size() : m_crowdDrawCount;
+	size_t previousTask = submitTask;
+
+	for (size_t group = 0; group < poseTasks.size(); ++group)
+	{
+		size_t begin = group * m_crowd.m_grainSize;
+		size_t end = begin + m_crowd.m_grainSize < drawnCount ? begin + m_crowd.m_grainSize : drawnCount;
+
+		if (begin >= drawnCount)
+			break;
+
+		size_t drawTask = m_frameGraph.addTask([this, begin, end]()
+		{
+			drawCrowd(begin > 0 ? begin : 1, end);
+		}, TaskThread::Caller);
+
+		m_frameGraph.addDependency(poseTasks[group], drawTask);
+		m_frameGraph.addDependency(previousTask, drawTask);
+
+		previousTask = drawTask;
+	}
+}
+
+/// Bake the world poses of the clips that fit the budget and release their per key world transforms
+void				MySimulation::initPoseCache()
+{
+	/*The walk is played by every step so it is baked first*/
+	m_poseCache.bake(m_skeleton, { &m_walkAnimation.m_clip, &m_runAnimation.m_clip }, m_poseCacheBudget);
+
+	for (Animation* animation : { &m_walkAnimation, &m_runAnimation })
+	{
+		if (m_poseCache.isBaked(animation->m_clip))
+		{
+			animation->m_worldTransforms.clear();
+			animation->m_worldTransforms.shrink_to_fit();
+		}
+	}
+
+	std::cout << "World pose cache : " << m_poseCache.bakedClipCount() << " clips baked, " 
+			  << m_poseCache.footprint() << " bytes of " << m_poseCacheBudget << std::endl;
+}
 
-		for (int j = 0; j < _animKeyCount; ++j)
+/// Detect the foot plants of the walk and the run and put them in the sync group of step 6
+void				MySimulation::initLocomotion()
+{
+	int leftFoot = findBone("foot_l");
+	int rightFoot = findBone("foot_r");
+
+	for (Animation* animation : { &m_walkAnimation, &m_runAnimation })
+	{
+		/*The mannequin comes from Unreal Engine, Z is up*/
+		if (leftFoot != -1 && rightFoot != -1)
 		{
-			_skeleton[index].m_localTransforms[j].m_scale = { 1.f, 1.f, 1.f };
-			_skeleton[index].m_worldTransforms[j].m_scale = { 1.f, 1.f, 1.f };
+			detectFootPlants(animation->m_clip, m_skeleton, leftFoot, rightFoot, LibMath::Vector3(0.f, 0.f, 1.f));
 		}
+
+		m_locomotion.addClip(animation->m_clip);
+	}
+
+	m_locomotion.setWeight(0, 1.f);
+
+	std::cout << "Foot plants :";
+
+	for (SyncMarker const& marker : m_walkAnimation.m_clip.m_syncMarkers)
+	{
+		std::cout << " walk " << (marker.m_foot == Foot::Left ? "left " : "right ") << marker.m_phase;
+	}
+
+	for (SyncMarker const& marker : m_runAnimation.m_clip.m_syncMarkers)
+	{
+		std::cout << " run " << (marker.m_foot == Foot::Left ? "left " : "right ") << marker.m_phase;
 	}
+
+	std::cout << std::endl;
+}
+
+/// Build the walk and run state machine of step 7 and start its playback
+void				MySimulation::initLocomotionMachine()
+{
+	size_t walk = m_locomotionMachine.addState("walk", m_walkAnimation.m_clip);
+	size_t run = m_locomotionMachine.addState("run", m_runAnimation.m_clip);
+
+	m_speedParameter = m_locomotionMachine.addParameter("speed");
+
+	/*The thresholds leave a gap so a speed hovering around one of them does not restart the fade every frame*/
+	StateTransition toRun;
+	toRun.m_from = walk;
+	toRun.m_to = run;
+	toRun.m_condition = { ConditionType::Greater, m_speedParameter, 0.6f };
+	toRun.m_fadeDuration = 0.3f;
+	toRun.m_isPhaseMatched = true;
+
+	StateTransition toWalk = toRun;
+	toWalk.m_from = run;
+	toWalk.m_to = walk;
+	toWalk.m_condition = { ConditionType::Less, m_speedParameter, 0.4f };
+
+	m_locomotionMachine.addTransition(toRun);
+	m_locomotionMachine.addTransition(toWalk);
+
+	m_locomotionState.initialize(m_locomotionMachine);
 }
 
 /// Initialize the simulation
@@ -60,11 +248,26 @@ void				MySimulation::init()
 	getBoneInformations(m_walkAnimation.m_skeletonAnim);
 	getBoneInformations(m_runAnimation.m_skeletonAnim);
 
-	getAnimationInformations("ThirdPersonWalk.anim", m_walkAnimation.m_skeletonAnim, m_walkAnimation.m_frameCount);
-	getAnimationInformations("ThirdPersonRun.anim", m_runAnimation.m_skeletonAnim, m_runAnimation.m_frameCount);
+	getAnimationInformations("ThirdPersonWalk.anim", m_walkAnimation);
+	getAnimationInformations("ThirdPersonRun.anim", m_runAnimation);
+
+	initScale(m_walkAnimation);
+	initScale(m_runAnimation);
+
+	/*Store the tracks that never change once so sampling skips them*/
+	m_walkAnimation.m_clip.classifyTracks();
+	m_runAnimation.m_clip.classifyTracks();
+
+	printAnimationFootprint("ThirdPersonWalk.anim", m_walkAnimation);
+	printAnimationFootprint("ThirdPersonRun.anim", m_runAnimation);
 
-	initScale(m_walkAnimation.m_skeletonAnim, m_walkAnimation.m_frameCount);
-	initScale(m_runAnimation.m_skeletonAnim, m_runAnimation.m_frameCount);
+	initSkeleton();
+
+	initPoseCache();
+
+	initLocomotion();
+
+	initLocomotionMachine();
 }
 
 /// Print the bone hierarchy
@@ -107,6 +310,17 @@ void				MySimulation::printBoneHierarchyWithoutIK()
 	}
 }
 
+/// Print the memory used by the keys of an animation and the classes of its tracks
+void				MySimulation::printAnimationFootprint(const char* _animName, Animation const& _animation)
+{
+	AnimationClip const& clip = _animation.m_clip;
+
+	std::cout << _animName << " : " << clip.m_keyCount << " keys x " << clip.m_boneCount << " bones, " 
+			  << clip.footprint() << " bytes, " << clip.trackClassCount(TrackClass::Constant) << " constant, " 
+			  << clip.trackClassCount(TrackClass::RotationOnly) << " rotation only and " 
+			  << clip.trackClassCount(TrackClass::Animated) << " animated bones" << std::endl;
+}
+
 /// Get the number of bones without the IK bones
 void				MySimulation::getBoneCount()
 {
@@ -119,6 +333,18 @@ void				MySimulation::getBoneCount()
 	}
 }
 
+/// Get the index of a bone by name, -1 if it is not found
+int					MySimulation::findBone(const char* _boneName)
+{
+	for (int i = 0; i < m_boneCount; ++i)
+	{
+		if (strcmp(GetSkeletonBoneName(i), _boneName) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
 /// Get the bone information
 void				MySimulation::getBoneInformations(std::vector<Bone>& _skeleton)
 {
@@ -145,24 +371,51 @@ void				MySimulation::getSkeletonBoneLocalBindTransform(int _boneIndex, LibMath:
 }
 
 /// Get animation informations
-void				MySimulation::getAnimationInformations(const char* _animName, std::vector<Bone>& _skeleton, 
-														   size_t _animKeyCount)
+void				MySimulation::getAnimationInformations(const char* _animName, Animation& _animation)
 {
-	for (int i = 0; i < m_boneCount; ++i)
+	AnimationClip& clip = _animation.m_clip;
+	std::vector<Bone>& skeleton = _animation.m_skeletonAnim;
+
+	/*Read the keys straight from the mapped file instead of one engine call per bone and key*/
+	AnimationFile file;
+	std::string path = m_resourceDirectory + _animName;
+
+	if (file.open(path.c_str()) && file.validate())
 	{
-		_skeleton[i].m_localTransforms.resize(_animKeyCount);
-		_skeleton[i].m_worldTransforms.resize(_animKeyCount);
+		_animation.m_frameCount = file.keyCount();
 
-		for (int j = 0; j < _animKeyCount; ++j)
+		file.toClip(clip, m_boneCount);
+	}
+	else
+	{
+		std::cout << path << " : " << file.error() << ", falling back to the engine" << std::endl;
+
+		/*Allocate the keys of every bone contiguously*/
+		clip.resize(m_boneCount, _animation.m_frameCount);
+		clip.m_duration = getAnimationDuration(_animation.m_frameCount, 1.f / 30.f);
+
+		/*Fill the keys in key-major order*/
+		for (int j = 0; j < _animation.m_frameCount; ++j)
 		{
-			getAnimLocalBoneTransform(_animName, i, j, _skeleton[i].m_localTransforms[j].m_position,
-				_skeleton[i].m_localTransforms[j].m_rotation);
+			for (int i = 0; i < m_boneCount; ++i)
+			{
+				Transform key = clip.getKey(j, i);
+
+				getAnimLocalBoneTransform(_animName, i, j, key.m_position, key.m_rotation);
+				clip.setKey(j, i, key);
+			}
 		}
+	}
+
+	_animation.m_worldTransforms.resize(clip.m_keyCount * clip.m_boneCount);
+
+	for (int i = 0; i < m_boneCount; ++i)
+	{
 		/*Get bone parent index*/
-		_skeleton[i].m_parentIndex = GetSkeletonBoneParentIndex(i);
+		skeleton[i].m_parentIndex = GetSkeletonBoneParentIndex(i);
 
 		/*Make sure the parent index is valid*/
-		assert(_skeleton[i].m_parentIndex < i);
+		assert(skeleton[i].m_parentIndex < i);
 	}
 }
 
@@ -175,65 +428,12 @@ void				MySimulation::getAnimLocalBoneTransform(const char* _animeName, int _bon
 							  _rotation.m_a, _rotation.m_b, _rotation.m_c, _rotation.m_d);
 }
 
-/// Get the next frame transform
-void				MySimulation::getTheNextFrameTransform(std::vector<Bone>& _skeleton, size_t _animKeyCount)
-{
-	for (int i = 0; i < m_boneCount; ++i)
-	{
-		int ancestorIndex = _skeleton[i].m_parentIndex;
-
-		int nextFrame = (m_currentFrame + 1) % _animKeyCount;
-
-		if (nextFrame >= _animKeyCount)
-		{
-			nextFrame = 0;
-		}
-
-		/*Update with anim by combining the local transform at the current frame with the local transform*/
-		_skeleton[i].m_worldTransforms[nextFrame] = _skeleton[i].m_localTransforms[nextFrame] *
-													_skeleton[i].m_localTransform;
-
-		if (ancestorIndex != -1)
-		{
-			/*update the world transform by combining the world transform at the current frame with the world transform*/
-			_skeleton[i].m_worldTransforms[nextFrame] = _skeleton[i].m_worldTransforms[nextFrame] *
-														_skeleton[ancestorIndex].m_worldTransforms[nextFrame];
-		}
-	}
-}
-
 /// Get animation duration
 float				MySimulation::getAnimationDuration(size_t _animKeyCount, float _frameTime)
 {
 	return _animKeyCount * _frameTime;
 }
 
-Transform			MySimulation::GetThefinalTransform(float& _frameTime)
-{
-	if (m_transitionProgress < 1.f)
-	{
-		m_transitionProgress += _frameTime / m_transitionTime;
-	}
-	if (m_transitionProgress > 1.f)
-	{
-		m_transitionProgress = 1.f;
-	}
-
-	float walkSpeed = 30.f / m_currentAnimation->m_frameCount;
-	float runSpeed = 30.f / m_nextAnimation->m_frameCount;
-
-	float interpolatedSpeed = walkSpeed + (runSpeed - walkSpeed) * m_transitionProgress;
-
-	float currentFrameTime = _frameTime * interpolatedSpeed;
-
-	Transform walkTransform = interpolateAnimation(m_currentAnimation, currentFrameTime);
-	Transform runTransform = interpolateAnimation(m_nextAnimation, currentFrameTime);
-
-	Transform finalTransform = interpolate(walkTransform, runTransform, m_transitionProgress);
-
-	return finalTransform;
-}
-
 /// Update the simulation
 void				MySimulation::update(float frameTime)
 {
@@ -247,11 +447,61 @@ void				MySimulation::update(float frameTime)
 	///*Draw world axis*/
 	//drawWorldMarker();
 
-	///*Process steps*/
-	step1(frameTime);
-	//step2(frameTime);
-	//step3(frameTime);
-	//step4(frameTime);
+	m_updatedBoneCount = 0;
+
+	m_frameArena.reset();
+
+	///*Process the selected step*/
+	switch (m_step)
+	{
+	case 2:
+		step2(frameTime);
+		break;
+	case 3:
+		step3(frameTime);
+		break;
+	case 4:
+		step4(frameTime);
+		break;
+	case 5:
+		step5(frameTime);
+		break;
+	case 6:
+		step6(frameTime);
+		break;
+	case 7:
+		step7(frameTime);
+		break;
+	default:
+		step1(frameTime);
+		break;
+	}
+
+	m_totalUpdatedBoneCount += m_updatedBoneCount;
+}
+
+/// Select the step processed by update, from 1 to 7
+void				MySimulation::selectStep(int _step)
+{
+	m_step = _step;
+}
+
+/// Select the palette format sent to the engine, it must match the shader of skinning.program
+void				MySimulation::selectPaletteFormat(PaletteFormat _paletteFormat)
+{
+	m_paletteFormat = _paletteFormat;
+}
+
+/// Set the directory of the .anim and .skel files, must end with a separator
+void				MySimulation::setResourceDirectory(const char* _resourceDirectory)
+{
+	m_resourceDirectory = _resourceDirectory;
+}
+
+/// Set the bytes the baked world poses can use before init, 0 to disable the bake
+void				MySimulation::setPoseCacheBudget(size_t _poseCacheBudget)
+{
+	m_poseCacheBudget = _poseCacheBudget;
 }
 
 /// Draw axis of the world
@@ -304,162 +554,124 @@ void				MySimulation::frameCounter(float _frameTime, size_t _animKeyCount)
 	m_currentPartialFrame = m_accumulatedTime / frameDuration;
 }
 
-/// Interpolate between current frame and next frame
-Transform			MySimulation::interpolateBetweenFrames(int& _index, std::vector<Bone>& _skeleton, int& _frame, 
-														   size_t& _animKeyCount)
+void				MySimulation::bindSkeletonToAnimation(Animation& _animation)
 {
-	Transform result;
-
-	if (m_currentFrame + 1 < _animKeyCount)
-	{
-		result = interpolate(_skeleton[_index].m_worldTransforms[_frame],
-							 _skeleton[_index].m_worldTransforms[_frame + 1], m_currentPartialFrame);
-	}
-	else
-	{
-		result = interpolate(_skeleton[_index].m_worldTransforms[_frame],
-							 _skeleton[_index].m_worldTransforms[0], m_currentPartialFrame);
-	}
-
-	return result;
+	/*World transforms of every bone at the current frame*/
+	evaluateKeyHierarchy(_animation, _animation.m_currentKey, m_currentFrame);
 }
 
-Transform MySimulation::interpolateAnimation(Animation* _anim, float _frameTime)
+/// Pose a key through a hierarchy, recomposing only the bones whose key changed, and store its world transforms
+void				MySimulation::evaluateKeyHierarchy(Animation& _animation, KeyHierarchy& _hierarchy, int _key)
 {
-	int frameIndex = static_cast<int>(_frameTime) % _anim->m_frameCount;
+	/*Paused playback or a frame shorter than a key : the world transforms of the key are already stored*/
+	if (_hierarchy.m_key == _key)
+		return;
 
-	return _anim->m_skeletonAnim[frameIndex].m_localTransform;
-}
+	/*A baked clip already holds the world transforms of every key*/
+	if (m_poseCache.isBaked(_animation.m_clip))
+		return;
+
+	std::vector<Bone>& skeleton = _animation.m_skeletonAnim;
+	AnimationClip const& clip = _animation.m_clip;
+	HierarchyEvaluator& evaluator = _hierarchy.m_evaluator;
 
-void				MySimulation::bindSkeletonToAnimation(std::vector<Bone>& _skeleton)
-{
 	for (int i = 0; i < m_boneCount; ++i)
 	{
-		int ancestorIndex = _skeleton[i].m_parentIndex;
-
-		if (i == 0)
-		{
-			/*Init root bind position/rotation*/
-			_skeleton[0].m_worldTransform = _skeleton[0].m_localTransform;
-		}
+		Transform key = clip.getKey(_key, i);
 
-		else
-		{
-			/*Update with anim by combining the local transform at the current frame with the local transform*/
-			_skeleton[i].m_worldTransforms[m_currentFrame] = _skeleton[i].m_localTransforms[m_currentFrame] *
-															 _skeleton[i].m_localTransform;
+		/*A constant track keeps its local transform, its world transform only moves with its parent*/
+		if (_hierarchy.m_key != -1 && key == clip.getKey(_hierarchy.m_key, i))
+			continue;
 
-			/*update the world transform by combining the world transform at the current frame with the world transform*/
-			_skeleton[i].m_worldTransforms[m_currentFrame] = _skeleton[i].m_worldTransforms[m_currentFrame] *
-															 _skeleton[ancestorIndex].m_worldTransforms[m_currentFrame];
-		}
+		/*Combine the key with the local bind transform, the evaluator adds the parent transform*/
+		evaluator.setLocalTransform(i, key * skeleton[i].m_localTransform);
 	}
-}
 
-void				MySimulation::animateTheMesh(std::vector<Bone>& _skeleton, std::vector<LibMath::Matrix4>& _skinningMatrix,
-												 LibMath::Matrix4& _boneMatrix, int _index, int _ancestorIndex)
-{
-	if (_ancestorIndex != -1)
-	{
-		_skeleton[_index].m_worldTransform = _skeleton[_index].m_localTransform * _skeleton[_ancestorIndex].m_worldTransform;
-	}
+	m_updatedBoneCount += evaluator.evaluate();
 
-	/*Get the inverse of the local transform to place in bone space*/
-	LibMath::Matrix4 localMatrixInverse = transformToMatrix4(_skeleton[_index].m_worldTransform).GetInverse();
+	std::copy(evaluator.worldPose(), evaluator.worldPose() + m_boneCount, 
+			  &_animation.m_worldTransforms[clip.keyIndex(_key, 0)]);
 
-	/**/
-	LibMath::Matrix4 skinningMatrix = localMatrixInverse * _boneMatrix;
-
-	_skinningMatrix.push_back(skinningMatrix);
+	_hierarchy.m_key = _key;
 }
 
-LibMath::Matrix4	MySimulation::createInterpolatedMatrix(int _index, std::vector<Bone>& _skeleton, int _frame, 
-														   size_t _animKeyCount)
+/// Get the world pose of a key, baked or stored by the hierarchies
+const Transform*	MySimulation::keyWorldPose(Animation const& _animation, int _key) const
 {
-	Transform interpolatedWorldTransforms = interpolateBetweenFrames(_index, _skeleton, _frame, _animKeyCount);
-
-	/*Convert the bone transform to a matrix*/
-	LibMath::Matrix4 boneMatrix = transformToMatrix4(interpolatedWorldTransforms);
+	const Transform* worldPose = m_poseCache.worldPose(_animation.m_clip, _key);
 
-	return boneMatrix;
+	return worldPose != nullptr ? worldPose : &_animation.m_worldTransforms[_animation.m_clip.keyIndex(_key, 0)];
 }
 
-void				MySimulation::playAnimation(std::vector<Bone>& _skeleton, size_t& _animKeyCount, int& _currentFrame, 
-												float& _frameTime)
+/// Sample the local keys between a frame and the next one, the last key loops to the first, then pose them in one pass
+void				MySimulation::sampleWorldPose(Animation const& _animation, int _frame, float _partialFrame)
 {
-	frameCounter(_frameTime, _animKeyCount);
-
-	if (m_isTransitioning)
-	{
-		m_currentFrame = 0;
-		m_accumulatedTime = 0.f;
-	}
+	/*Paused playback : the world pose of the last call is still valid*/
+	if (m_sampledAnimation == &_animation && m_sampledFrame == _frame && m_sampledPartialFrame == _partialFrame)
+		return;
 
-	bindSkeletonToAnimation(_skeleton);
+	int nextFrame = _frame + 1 < _animation.m_frameCount ? _frame + 1 : 0;
 
-	/*Create vector to store all skinning matrices*/
-	std::vector<LibMath::Matrix4> skinningMatrices;
+	m_localPose.resize(m_boneCount);
+	m_worldPose.resize(m_boneCount);
 
-	getTheNextFrameTransform(_skeleton, _animKeyCount);
+	/*Both keys are read from the clip at the same time so the pose never mixes two frames*/
+	_animation.m_clip.samplePose(_frame, nextFrame, _partialFrame, m_localPose.data());
 
-	for (int i = 0; i < m_boneCount; ++i)
-	{
-		int ancestorIndex = _skeleton[i].m_parentIndex;
+	m_skeleton.computeWorldPose(m_localPose.data(), m_worldPose.data());
 
-		animateTheMesh(_skeleton, skinningMatrices, createInterpolatedMatrix(i, _skeleton, _currentFrame,
-					   _animKeyCount), i, ancestorIndex);
-	}
-	
-	m_isTransitioning = false;
+	m_updatedBoneCount += m_boneCount;
 
-	SetSkinningPose(&skinningMatrices[0][0][0], m_boneCount);
+	m_sampledAnimation = &_animation;
+	m_sampledFrame = _frame;
+	m_sampledPartialFrame = _partialFrame;
 }
 
-/// Switch between transition without crossfading
-void				MySimulation::switchAnimation(float _frameTime)
+/// Build the skinning palette of a world pose in the selected format and send it to the engine
+void				MySimulation::submitSkinningPose(const Transform* _worldPose)
 {
-	if (m_currentFrame >= m_walkAnimation.m_frameCount - 1 && m_walkAnimation.m_isActivated)
-	{
-		m_walkAnimation.m_isActivated = false;
-		m_runAnimation.m_isActivated = true;
-		m_isTransitioning = true;
-	}
-	else if (m_currentFrame >= m_runAnimation.m_frameCount - 1 && m_runAnimation.m_isActivated)
-	{
-		m_runAnimation.m_isActivated = false;
-		m_walkAnimation.m_isActivated = true;
-		m_isTransitioning = true;
-	}
+	/*The palettes are padded because the engine copies 16 floats per count*/
+	size_t capacity = paletteCapacity(m_paletteFormat, m_boneCount);
+	const float* palette = nullptr;
 
-	if (m_walkAnimation.m_isActivated)
-	{
-		playAnimation(m_walkAnimation.m_skeletonAnim, m_walkAnimation.m_frameCount, m_currentFrame, _frameTime);
-	}
-	else if (m_runAnimation.m_isActivated)
+	switch (m_paletteFormat)
 	{
-		playAnimation(m_runAnimation.m_skeletonAnim, m_runAnimation.m_frameCount, m_currentFrame, _frameTime);
+	case PaletteFormat::Affine:
+		m_affinePalette.resize(capacity);
+		m_skeleton.computeSkinningPalette(_worldPose, m_affinePalette.data());
+		palette = &m_affinePalette[0].m_matrix[0][0];
+		break;
+	case PaletteFormat::DualQuaternion:
+		m_dualQuaternionPalette.resize(capacity);
+		m_skeleton.computeSkinningPalette(_worldPose, m_dualQuaternionPalette.data());
+		palette = m_dualQuaternionPalette[0].m_real;
+		break;
+	default:
+		m_palette.resize(capacity);
+		m_skeleton.computeSkinningPalette(_worldPose, m_palette.data());
+		palette = &m_palette[0].m_matrix[0][0];
+		break;
 	}
+
+	SetSkinningPose(palette, paletteSubmitCount(m_paletteFormat, m_boneCount));
 }
 
 /// Step 1 : draw the skeleton by using the bind pose and regarding the hierarchy
 void				MySimulation::step1(float frameTime)
 {
-	/*Init root bind position/rotation*/
-	m_walkAnimation.m_skeletonAnim[0].m_worldTransform = m_walkAnimation.m_skeletonAnim[0].m_localTransform;
+	/*The bind pose is composed on the first frame, the next ones find nothing dirty*/
+	m_updatedBoneCount += m_bindPoseHierarchy.evaluate();
 
 	for (int i = 1; i < m_boneCount; ++i)
 	{
 		/*Get the parent index*/
 		int ancestorIndex = m_walkAnimation.m_skeletonAnim[i].m_parentIndex;
 
-		/*Combine the local transform with the parent transform*/
-		m_walkAnimation.m_skeletonAnim[i].m_worldTransform = m_walkAnimation.m_skeletonAnim[i].m_localTransform * 
-															 m_walkAnimation.m_skeletonAnim[ancestorIndex].m_worldTransform;
+		LibMath::Vector3 childPosition = m_bindPoseHierarchy.worldTransform(i).m_position;
+		LibMath::Vector3 parentPosition = m_bindPoseHierarchy.worldTransform(ancestorIndex).m_position;
 
 		/*Draw the bone*/
-		drawSkeleton(m_walkAnimation.m_skeletonAnim[i].m_worldTransform.m_position, 
-					 m_walkAnimation.m_skeletonAnim[ancestorIndex].m_worldTransform.m_position,
-					 m_offset, { 0.95, 0.22, 0.42 });
+		drawSkeleton(childPosition, parentPosition, m_offset, { 0.95, 0.22, 0.42 });
 	}
 }
 
@@ -468,16 +680,20 @@ void				MySimulation::step2(float frameTime)
 {
 	frameCounter(frameTime, m_walkAnimation.m_frameCount);
 
-	bindSkeletonToAnimation(m_walkAnimation.m_skeletonAnim);
+	bindSkeletonToAnimation(m_walkAnimation);
+
+	/*World transforms of every bone at the current frame*/
+	const Transform* worldTransforms = keyWorldPose(m_walkAnimation, m_currentFrame);
 
 	for (int i = 1; i < m_boneCount; ++i)
 	{
 		int ancestorIndex = m_walkAnimation.m_skeletonAnim[i].m_parentIndex;
 
+		LibMath::Vector3 childPosition = worldTransforms[i].m_position;
+		LibMath::Vector3 parentPosition = worldTransforms[ancestorIndex].m_position;
+
 		/*Draw the bone for each frame*/
-		drawSkeleton(m_walkAnimation.m_skeletonAnim[i].m_worldTransforms[m_currentFrame].m_position,
-					 m_walkAnimation.m_skeletonAnim[ancestorIndex].m_worldTransforms[m_currentFrame].m_position,
-					 m_offset, { 0.95, 0.22, 0.42 });
+		drawSkeleton(childPosition, parentPosition, m_offset, { 0.95, 0.22, 0.42 });
 	}
 }
 
@@ -486,42 +702,122 @@ void				MySimulation::step3(float frameTime)
 {
 	frameCounter(frameTime, m_walkAnimation.m_frameCount);
 
-	bindSkeletonToAnimation(m_walkAnimation.m_skeletonAnim);
+	bindSkeletonToAnimation(m_walkAnimation);
 
-	///*Create vector to store all skinning matrices*/
-	std::vector<LibMath::Matrix4> skinningMatrices;
+	/*World transforms of every bone at the current frame*/
+	submitSkinningPose(keyWorldPose(m_walkAnimation, m_currentFrame));
+}
 
-	for (int i = 0; i < m_boneCount; ++i)
+/// Step 4 : Interpolate poses between frames
+void				MySimulation::step4(float frameTime)
+{
+	frameCounter(frameTime, m_walkAnimation.m_frameCount);
+
+	sampleWorldPose(m_walkAnimation, m_currentFrame, m_currentPartialFrame);
+
+	submitSkinningPose(m_worldPose.data());
+}
+
+/// Step 5 : Animate a crowd sharing the clips and the skeleton
+void				MySimulation::step5(float frameTime)
+{
+	if (m_crowd.m_instances.size() != m_crowdSize)
 	{
-		int ancestorIndex = m_walkAnimation.m_skeletonAnim[i].m_parentIndex;
+		initCrowd();
+	}
+
+	/*Submission and drawing run on this thread as soon as the characters they read are evaluated*/
+	m_crowd.update(frameTime, m_frameGraph, *m_threadPool);
+}
+
+/// Draw the characters of the crowd from _begin to _end as skeletons on a grid
+void				MySimulation::drawCrowd(size_t _begin, size_t _end)
+{
+	size_t rowSize = 8;
 
-		/*Convert the bone transform to a matrix*/
-		LibMath::Matrix4 boneMatrix = transformToMatrix4(m_walkAnimation.m_skeletonAnim[i].m_worldTransforms[m_currentFrame]);
+	for (size_t j = _begin; j < _end; ++j)
+	{
+		std::vector<Transform> const& worldPose = m_crowd.m_instances[j].m_worldPose;
 
-		animateTheMesh(m_walkAnimation.m_skeletonAnim, skinningMatrices, boneMatrix, i, ancestorIndex);
+		LibMath::Vector3 gridOffset(float(j % rowSize) * 150.f, 0.f, float(j / rowSize) * 150.f);
+
+		for (int i = 1; i < m_boneCount; ++i)
+		{
+			int ancestorIndex = m_skeleton.m_parentIndices[i];
+
+			LibMath::Vector3 childPosition = worldPose[i].m_position + gridOffset;
+			LibMath::Vector3 parentPosition = worldPose[ancestorIndex].m_position + gridOffset;
+
+			drawSkeleton(childPosition, parentPosition, m_offset, { 0.22, 0.62, 0.95 });
+		}
 	}
-	SetSkinningPose(&skinningMatrices[0][0][0], m_boneCount);
 }
 
-/// Step 4 : Interpolate poses between frames
-void				MySimulation::step4(float frameTime)
+/// Step 6 : Blend the walk and the run in phase, the weight of the run going back and forth
+void				MySimulation::step6(float frameTime)
 {
-	frameCounter(frameTime, m_walkAnimation.m_frameCount);
+	m_transitionProgress = std::fmod(m_transitionProgress + frameTime / m_transitionTime, 2.f);
 
-	bindSkeletonToAnimation(m_walkAnimation.m_skeletonAnim);
+	float runWeight = m_transitionProgress < 1.f ? m_transitionProgress : 2.f - m_transitionProgress;
 
-	/*Create vector to store all skinning matrices*/
-	std::vector<LibMath::Matrix4> skinningMatrices;
+	/*The cycle lasts from the walk to the run duration and both clips plant the same foot together*/
+	m_locomotion.setWeight(0, 1.f - runWeight);
+	m_locomotion.setWeight(1, runWeight);
+	m_locomotion.advance(frameTime);
 
-	getTheNextFrameTransform(m_walkAnimation.m_skeletonAnim, m_walkAnimation.m_frameCount);
+	m_localPose.resize(m_boneCount);
+	m_worldPose.resize(m_boneCount);
 
-	for (int i = 0; i < m_boneCount; ++i)
+	/*The shared pose buffers no longer hold the frame sampled by step 4*/
+	m_sampledAnimation = nullptr;
+
+	Transform* runLocalPose = m_frameArena.allocate<Transform>(m_boneCount);
+
+	/*Each clip is sampled once at its own time, a clip of weight 0 is skipped by the blend*/
+	if (runWeight < 1.f)
 	{
-		int ancestorIndex = m_walkAnimation.m_skeletonAnim[i].m_parentIndex;
+		m_walkAnimation.m_clip.sampleTime(m_locomotion.time(0), m_localPose.data());
+	}
 
-		animateTheMesh(m_walkAnimation.m_skeletonAnim, skinningMatrices, 
-					   createInterpolatedMatrix(i, m_walkAnimation.m_skeletonAnim, m_currentFrame, m_walkAnimation.m_frameCount),
-					   i, ancestorIndex);
+	if (runWeight > 0.f)
+	{
+		m_runAnimation.m_clip.sampleTime(m_locomotion.time(1), runLocalPose);
 	}
-	SetSkinningPose(&skinningMatrices[0][0][0], m_boneCount);
-}
\ No newline at end of file
+
+	/*Both poses are relative to the same bind pose so they are blended before the single FK pass*/
+	blendPoses(m_localPose.data(), runLocalPose, runWeight, m_boneCount, m_localPose.data(),
+			   m_walkAnimation.m_clip.m_rotationInterpolation);
+
+	m_skeleton.computeWorldPose(m_localPose.data(), m_worldPose.data());
+
+	m_updatedBoneCount += m_boneCount;
+
+	submitSkinningPose(m_worldPose.data());
+}
+
+/// Step 7 : Cross-fade between the walk and the run through a state machine driven by the speed
+void				MySimulation::step7(float frameTime)
+{
+	m_speedProgress = std::fmod(m_speedProgress + frameTime / m_transitionTime, 2.f);
+
+	float speed = m_speedProgress < 1.f ? m_speedProgress : 2.f - m_speedProgress;
+
+	m_locomotionState.setParameter(m_speedParameter, speed);
+	m_locomotionState.update(frameTime);
+
+	m_localPose.resize(m_boneCount);
+	m_worldPose.resize(m_boneCount);
+
+	m_sampledAnimation = nullptr;
+
+	Transform* fadingLocalPose = m_frameArena.allocate<Transform>(m_boneCount);
+
+	/*Only the current state and, during a cross-fade, the state it leaves are sampled*/
+	m_locomotionState.evaluate(m_localPose.data(), fadingLocalPose);
+
+	m_skeleton.computeWorldPose(m_localPose.data(), m_worldPose.data());
+
+	m_updatedBoneCount += m_boneCount;
+
+	submitSkinningPose(m_worldPose.data());
+}
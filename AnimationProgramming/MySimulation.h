@@ -4,11 +4,25 @@
 
 #include "Simulation.h"
 #include "Transform.h"
+#include "AnimationClip.h"
+#include "Skeleton.h"
+#include "Skinning.h"
+#include "Crowd.h"
+#include "ThreadPool.h"
+#include "TaskGraph.h"
+#include "FrameArena.h"
+#include "HierarchyEvaluator.h"
+#include "WorldPoseCache.h"
+#include "PoseBlend.h"
+#include "SyncGroup.h"
+#include "AnimationStateMachine.h"
 
 #pragma endregion
 
 #pragma region Standard
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #pragma endregion
@@ -23,51 +37,99 @@
 
 struct Bone
 {
-	std::vector<Transform>	m_localTransforms; // Vector to store local transforms by frame
-	std::vector<Transform>	m_worldTransforms; // Vector to store world transforms by frame
-
 	Transform				m_localTransform; // Local transform
 	Transform				m_worldTransform; // World transform/bind pose
 
 	int						m_parentIndex = 0; // Parent index
 };
 
+/// Hierarchy following one key of an animation, a bone is only recomposed when its key differs from the previous one
+struct KeyHierarchy
+{
+	HierarchyEvaluator		m_evaluator;
+
+	int						m_key = -1; // Key of the world pose held by the evaluator, -1 before the first one
+};
+
 struct Animation
 {
-	std::vector<Bone>	m_skeletonAnim;
+	std::vector<Bone>		m_skeletonAnim;
 
-	size_t				m_frameCount;
+	AnimationClip			m_clip; // Local keys of every bone stored key-major
+	std::vector<Transform>	m_worldTransforms; // World transform of every bone for every key, same layout as the clip, empty once baked
 
-	float				m_duration;
+	KeyHierarchy			m_currentKey; // World pose of the current frame
 
-	bool				m_isActivated = false;
+	size_t					m_frameCount;
 };
 
 class MySimulation : public ISimulation
 {
 	/// Variables
-	Animation*						m_currentAnimation = nullptr;
-	Animation*						m_nextAnimation = nullptr;
 	Animation						m_walkAnimation;
 	Animation						m_runAnimation;
 
+	Skeleton						m_skeleton; // Bind pose, hierarchy and inverse bind pose shared by every animation
+	HierarchyEvaluator				m_bindPoseHierarchy; // Bind pose drawn by step 1, only composed once
+	WorldPoseCache					m_poseCache; // World pose of every key of the clips baked at init
+	SyncGroup						m_locomotion; // Walk and run of step 6 sharing one phase
+	StateMachineDefinition			m_locomotionMachine; // Walk and run states of step 7 and their cross-fades
+	StateMachineInstance			m_locomotionState; // Playback of the locomotion machine by step 7
+	size_t							m_speedParameter = 0; // Parameter of the locomotion machine driven by step 7
+	size_t							m_poseCacheBudget = 256 * 1024; // Bytes the baked poses can use, 0 to disable the bake
+
+	Crowd							m_crowd; // Characters of step 5
+	std::unique_ptr<ThreadPool>		m_threadPool; // Workers updating the crowd, started with the crowd
+	TaskGraph						m_frameGraph; // Evaluation, submission and drawing of the crowd, built with the crowd
+	size_t							m_crowdSize = 256; // Number of characters of the crowd
+	size_t							m_crowdDrawCount = 64; // Number of characters drawn as skeletons
+
+	std::string						m_resourceDirectory = "Resources/"; // Directory of the .anim and .skel files
+
+	PaletteFormat					m_paletteFormat = PaletteFormat::Matrix4; // Palette layout sent to the engine
+	std::vector<Transform>			m_localPose; // Local pose sampled by steps 4, 6 and 7, relative to the bind pose
+	std::vector<Transform>			m_worldPose; // World pose of the sampled local pose, skinned by steps 4, 6 and 7
+	FrameArena						m_frameArena; // Temporaries of one update, released at the start of the next one
+
+	const Animation*				m_sampledAnimation = nullptr; // Animation of the last pose sampled by step 4, nullptr once another step wrote the pose
+	int								m_sampledFrame = -1; // Frame of the last sampled pose
+	float							m_sampledPartialFrame = 0.f; // Partial frame of the last sampled pose
+	std::vector<LibMath::Matrix4>	m_palette; // Palette sent in the Matrix4 format
+	std::vector<AffineMatrix>		m_affinePalette; // Palette sent in the affine format
+	std::vector<DualQuaternion>		m_dualQuaternionPalette; // Palette sent in the dual quaternion format
+
 	float 							m_accumulatedTime = 0.f; // Accumulated time
 	float							m_currentPartialFrame = 0.f;
 	float							m_offset = 50.f;
-	float							m_transitionTime = 2.f;
-	float							m_transitionProgress = 0.f;
+	float							m_transitionTime = 2.f; // Seconds for the blend of step 6 to go from the walk to the run
+	float							m_transitionProgress = 0.f; // Progress of the blend of step 6, from 0 to 2 and back
+	float							m_speedProgress = 0.f; // Progress of the speed of step 7, from 0 to 2 and back
 
 	size_t							m_boneCount = 0; // Number of bones
+	size_t							m_updatedBoneCount = 0; // Bones recomposed by the hierarchies during the last update
+	size_t							m_totalUpdatedBoneCount = 0; // Bones recomposed by the hierarchies since init
 
 	int 							m_currentFrame = 0; // Current walk animation frame
 	
-	bool							m_isTransitioning = false;
+	int								m_step = 1; // Step processed by update
 
 	/// Initialize
 	// Initialize members
 	void 					initMembers();
 	// Initialize the scale to {1.f, 1.f, 1.f}
-	void					initScale(std::vector<Bone>& _skeleton, int _animKeyCount);
+	void					initScale(Animation& _animation);
+	// Compute the bind pose world transforms once and build the skeleton shared by every animation
+	void					initSkeleton();
+	// Create the characters of the crowd and the worker threads that update them
+	void					initCrowd();
+	// Build the tasks of a crowd frame : evaluation on the pool, submission and drawing on the engine thread
+	void					initFrameGraph();
+	// Bake the world poses of the clips that fit the budget and release their per key world transforms
+	void					initPoseCache();
+	// Detect the foot plants of the walk and the run and put them in the sync group of step 6
+	void					initLocomotion();
+	// Build the walk and run state machine of step 7 and start its playback
+	void					initLocomotionMachine();
 	// Initialize the simulation
 	virtual void			init() override;
 
@@ -76,27 +138,27 @@ class MySimulation : public ISimulation
 	void					printBoneHierarchy();
 	// Print the bone hierarchy without the IK bones
 	void					printBoneHierarchyWithoutIK();
+	// Print the memory used by the keys of an animation and the classes of its tracks
+	void					printAnimationFootprint(const char* _animName, Animation const& _animation);
 
 	/// Getter
 	// Get the number of bones without the IK bones
 	void					getBoneCount();
+	// Get the index of a bone by name, -1 if it is not found
+	int						findBone(const char* _boneName);
 	// Get bone informations
 	void					getBoneInformations(std::vector<Bone>& _skeleton);
 	// Get skeleton bone local bind transform
 	void					getSkeletonBoneLocalBindTransform(int _boneIndex, LibMath::Vector3& _position, 
 															  LibMath::Quaternion& _rotation);
 	// Get the walk animation informations
-	void					getAnimationInformations(const char* _animName, std::vector<Bone>& _skeleton, size_t _animKeyCount);
+	void					getAnimationInformations(const char* _animName, Animation& _animation);
 
 	// Get the walk animation local bone transformation
 	void					getAnimLocalBoneTransform(const char* _animeName, int _boneIndex, int _frameIndex, 
 													  LibMath::Vector3& _position, LibMath::Quaternion& _rotation);
-	// Get the next frame transform
-	void					getTheNextFrameTransform(std::vector<Bone>& _skeleton, size_t _animKeyCount);
 	// Get animation duration
 	float 					getAnimationDuration(size_t _animKeyCount, float _frameTime);
-	// Get the result of interpolation between the two animations
-	Transform				GetThefinalTransform(float& _frameTime);
 
 	/// Update
 	// Update the simulation
@@ -108,38 +170,28 @@ class MySimulation : public ISimulation
 	// Draw skeleton
 	void					drawSkeleton(LibMath::Vector3& _childPosition, LibMath::Vector3& _parentPosition, 
 										 float _offset, LibMath::Vector3 _color);
+	// Draw the characters of the crowd from _begin to _end as skeletons on a grid
+	void					drawCrowd(size_t _begin, size_t _end);
 
 	/// Timer
 	// Frame counter to update animation in regard to the frameTime
 	void					frameCounter(float _frameTime, size_t _animKeyCount);
 
-	/// Interpolate
-	// Interpolate between current frame and next frame
-	Transform				interpolateBetweenFrames(int& _index, std::vector<Bone>& _skeleton, int& _frame, 
-													 size_t& _animKeyCount);
-	// Interpolate between two animation
-	Transform				interpolateAnimation(Animation* _anim, float _frameTime);
-
 	/// Bind
 	// Bind skeleton to animation
-	void					bindSkeletonToAnimation(std::vector<Bone>& _skeleton);
+	void					bindSkeletonToAnimation(Animation& _animation);
+	// Pose a key through a hierarchy, recomposing only the bones whose key changed, and store its world transforms
+	void					evaluateKeyHierarchy(Animation& _animation, KeyHierarchy& _hierarchy, int _key);
+	// Get the world pose of a key, baked or stored by the hierarchies
+	const Transform*		keyWorldPose(Animation const& _animation, int _key) const;
+
+	/// Sample
+	// Sample the local keys between a frame and the next one, the last key loops to the first, then pose them in one pass
+	void					sampleWorldPose(Animation const& _animation, int _frame, float _partialFrame);
 
 	/// Animate
-	// Animate the mesh in regard to the running animation
-	void					animateTheMesh(std::vector<Bone>& _skeleton, std::vector<LibMath::Matrix4>& _skinningMatrix,
-										   LibMath::Matrix4& _boneMatrix, int _index, int _ancestorIndex);
-
-	/// Create
-	// Create the interpolated matrix
-	LibMath::Matrix4		createInterpolatedMatrix(int _index, std::vector<Bone>& _skeleton, int _frame, size_t _animKeyCount);
-
-	/// Play
-	// Play animation
-	void					playAnimation(std::vector<Bone>& _skeleton, size_t& _animKeyCount, int& _currentFrame, 
-										  float& _frameTime);
-	/// Switch
-	// Switch between walk animation and run animation
-	void					switchAnimation(float _frameTime);	
+	// Build the skinning palette of a world pose in the selected format and send it to the engine
+	void					submitSkinningPose(const Transform* _worldPose);
 
 	/// Steps
 	// Step 1 : draw the skeleton by using the bind pose and regarding the hierarchy
@@ -150,5 +202,29 @@ class MySimulation : public ISimulation
 	void					step3(float frameTime);
 	// Step 4 : Interpolate poses between frames
 	void					step4(float frameTime);
+	// Step 5 : Animate a crowd sharing the clips and the skeleton
+	void					step5(float frameTime);
+	// Step 6 : Blend the walk and the run in phase, the weight of the run going back and forth
+	void					step6(float frameTime);
+	// Step 7 : Cross-fade between the walk and the run through a state machine driven by the speed
+	void					step7(float frameTime);
+
+public:
+
+	/// Setter
+	// Select the step processed by update, from 1 to 7
+	void					selectStep(int _step);
+	// Select the palette format sent to the engine, it must match the shader of skinning.program
+	void					selectPaletteFormat(PaletteFormat _paletteFormat);
+	// Set the directory of the .anim and .skel files, must end with a separator
+	void					setResourceDirectory(const char* _resourceDirectory);
+	// Set the bytes the baked world poses can use before init, 0 to disable the bake
+	void					setPoseCacheBudget(size_t _poseCacheBudget);
+
+	/// Getter
+	// Bones recomposed by the hierarchy evaluators during the last update
+	size_t					updatedBoneCount() const { return m_updatedBoneCount; }
+	// Bones recomposed by the hierarchy evaluators since init
+	size_t					totalUpdatedBoneCount() const { return m_totalUpdatedBoneCount; }
 
 }; // !class MySimulation
\ No newline at end of file
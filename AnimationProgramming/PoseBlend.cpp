@@ -0,0 +1,302 @@
+#include "PoseBlend.h"
+
+#pragma region LibMath
+
+#include "LibMath/Header/SIMD.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+#pragma endregion
+
+#if LIBMATH_X86
+#include <immintrin.h>
+#endif
+
+#pragma region Blend kernels
+
+namespace
+{
+	/// Poses of a blend with the weights already divided by their sum
+	struct BlendInput
+	{
+		const Transform* const*	m_poses;
+		const float*			m_weights;
+		size_t					m_poseCount;
+		size_t					m_referencePose; // First pose of non zero weight, its rotations choose the hemisphere
+		float					m_weightScale; // Inverse of the sum of the weights
+	};
+
+	/// Signature shared by every blend kernel
+	typedef void (*BlendKernel)(BlendInput const&, Transform*, size_t, size_t);
+
+	/// The SIMD kernels read a transform as ten floats : position, rotation from the third one, then scale
+	static_assert(sizeof(Transform) == 10 * sizeof(float), "Transform must be ten packed floats");
+
+	/// First float of a transform, whatever the order of the members of Vector3
+	const float*		floatsOf(Transform const& _transform)
+	{
+		return reinterpret_cast<const float*>(&_transform);
+	}
+
+	/// First float of a transform, whatever the order of the members of Vector3
+	float*				floatsOf(Transform& _transform)
+	{
+		return reinterpret_cast<float*>(&_transform);
+	}
+
+	/// Blend the bones from _begin to _end one at a time
+	void				blendPosesScalar(BlendInput const& _input, Transform* _result, size_t _begin, size_t _end)
+	{
+		for (size_t i = _begin; i < _end; ++i)
+		{
+			LibMath::Quaternion const& reference = _input.m_poses[_input.m_referencePose][i].m_rotation;
+
+			float position[3] = {};
+			float rotation[4] = {};
+			float scale[3] = {};
+
+			for (size_t pose = 0; pose < _input.m_poseCount; ++pose)
+			{
+				float weight = _input.m_weights[pose] * _input.m_weightScale;
+
+				if (weight == 0.f)
+					continue;
+
+				Transform const& transform = _input.m_poses[pose][i];
+
+				/*q and -q are the same rotation, the one closest to the reference is summed*/
+				float dot = transform.m_rotation.m_a * reference.m_a + transform.m_rotation.m_b * reference.m_b +
+							transform.m_rotation.m_c * reference.m_c + transform.m_rotation.m_d * reference.m_d;
+				float rotationWeight = dot < 0.f ? -weight : weight;
+
+				position[0] += weight * transform.m_position.m_x;
+				position[1] += weight * transform.m_position.m_y;
+				position[2] += weight * transform.m_position.m_z;
+
+				rotation[0] += rotationWeight * transform.m_rotation.m_a;
+				rotation[1] += rotationWeight * transform.m_rotation.m_b;
+				rotation[2] += rotationWeight * transform.m_rotation.m_c;
+				rotation[3] += rotationWeight * transform.m_rotation.m_d;
+
+				scale[0] += weight * transform.m_scale.m_x;
+				scale[1] += weight * transform.m_scale.m_y;
+				scale[2] += weight * transform.m_scale.m_z;
+			}
+
+			float inverseLength = 1.f / std::sqrt(rotation[0] * rotation[0] + rotation[1] * rotation[1] +
+												  rotation[2] * rotation[2] + rotation[3] * rotation[3]);
+
+			_result[i].m_position = LibMath::Vector3(position[0], position[1], position[2]);
+			_result[i].m_rotation = LibMath::Quaternion(rotation[0] * inverseLength, rotation[1] * inverseLength,
+														rotation[2] * inverseLength, rotation[3] * inverseLength);
+			_result[i].m_scale = LibMath::Vector3(scale[0], scale[1], scale[2]);
+		}
+	}
+
+#if LIBMATH_X86
+	/// Dot product of two quaternions broadcast to the four floats, with SSE2 shuffles only
+	__m128				dotSSE(__m128 _lhs, __m128 _rhs)
+	{
+		__m128 product = _mm_mul_ps(_lhs, _rhs);
+		__m128 sum = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+
+		return _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	}
+
+	/// Blend one bone at a time, a transform is read as three overlapping registers from its floats 0, 3 and 6
+	void				blendPosesSSE(BlendInput const& _input, Transform* _result, size_t _begin, size_t _end)
+	{
+		const __m128 signMask = _mm_set1_ps(-0.f);
+
+		for (size_t i = _begin; i < _end; ++i)
+		{
+			__m128 reference = _mm_loadu_ps(floatsOf(_input.m_poses[_input.m_referencePose][i]) + 3);
+
+			__m128 position = _mm_setzero_ps();
+			__m128 rotation = _mm_setzero_ps();
+			__m128 scale = _mm_setzero_ps();
+
+			for (size_t pose = 0; pose < _input.m_poseCount; ++pose)
+			{
+				float poseWeight = _input.m_weights[pose] * _input.m_weightScale;
+
+				if (poseWeight == 0.f)
+					continue;
+
+				const float* transform = floatsOf(_input.m_poses[pose][i]);
+
+				__m128 weight = _mm_set1_ps(poseWeight);
+				__m128 quaternion = _mm_loadu_ps(transform + 3);
+
+				/*The sign bit of the dot product flips the weight of a rotation in the other hemisphere*/
+				__m128 rotationWeight = _mm_xor_ps(weight, _mm_and_ps(dotSSE(quaternion, reference), signMask));
+
+				position = _mm_add_ps(position, _mm_mul_ps(weight, _mm_loadu_ps(transform)));
+				rotation = _mm_add_ps(rotation, _mm_mul_ps(rotationWeight, quaternion));
+				scale = _mm_add_ps(scale, _mm_mul_ps(weight, _mm_loadu_ps(transform + 6)));
+			}
+
+			rotation = _mm_div_ps(rotation, _mm_sqrt_ps(dotSSE(rotation, rotation)));
+
+			/*The registers overlap the rotation, it is stored last so it overwrites their extra floats*/
+			float* result = floatsOf(_result[i]);
+
+			_mm_storeu_ps(result, position);
+			_mm_storeu_ps(result + 6, scale);
+			_mm_storeu_ps(result + 3, rotation);
+		}
+	}
+
+	/// Put four floats of the first bone in the low lane and four of the second bone in the high lane
+	LIBMATH_TARGET_AVX
+	__m256				loadPairAVX(const float* _first, const float* _second)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(_first)), _mm_loadu_ps(_second), 1);
+	}
+
+	/// Store the low lane for the first bone and the high lane for the second one
+	LIBMATH_TARGET_AVX
+	void				storePairAVX(__m256 _value, float* _first, float* _second)
+	{
+		_mm_storeu_ps(_first, _mm256_castps256_ps128(_value));
+		_mm_storeu_ps(_second, _mm256_extractf128_ps(_value, 1));
+	}
+
+	/// Blend two bones at a time, each 128 bits lane holds the registers of the SSE kernel for one bone
+	LIBMATH_TARGET_AVX
+	void				blendPosesAVX(BlendInput const& _input, Transform* _result, size_t _begin, size_t _end)
+	{
+		const __m256 signMask = _mm256_set1_ps(-0.f);
+
+		size_t i = _begin;
+
+		for (; i + 2 <= _end; i += 2)
+		{
+			const float* referencePose = floatsOf(_input.m_poses[_input.m_referencePose][i]);
+			__m256 reference = loadPairAVX(referencePose + 3, referencePose + 13);
+
+			__m256 position = _mm256_setzero_ps();
+			__m256 rotation = _mm256_setzero_ps();
+			__m256 scale = _mm256_setzero_ps();
+
+			for (size_t pose = 0; pose < _input.m_poseCount; ++pose)
+			{
+				float poseWeight = _input.m_weights[pose] * _input.m_weightScale;
+
+				if (poseWeight == 0.f)
+					continue;
+
+				const float* transforms = floatsOf(_input.m_poses[pose][i]);
+
+				__m256 weight = _mm256_set1_ps(poseWeight);
+				__m256 quaternion = loadPairAVX(transforms + 3, transforms + 13);
+
+				/*The dot product of each lane is broadcast to its four floats*/
+				__m256 dot = _mm256_dp_ps(quaternion, reference, 0xFF);
+				__m256 rotationWeight = _mm256_xor_ps(weight, _mm256_and_ps(dot, signMask));
+
+				position = _mm256_add_ps(position, _mm256_mul_ps(weight, loadPairAVX(transforms, transforms + 10)));
+				rotation = _mm256_add_ps(rotation, _mm256_mul_ps(rotationWeight, quaternion));
+				scale = _mm256_add_ps(scale, _mm256_mul_ps(weight, loadPairAVX(transforms + 6, transforms + 16)));
+			}
+
+			rotation = _mm256_div_ps(rotation, _mm256_sqrt_ps(_mm256_dp_ps(rotation, rotation, 0xFF)));
+
+			float* result = floatsOf(_result[i]);
+
+			storePairAVX(position, result, result + 10);
+			storePairAVX(scale, result + 6, result + 16);
+			storePairAVX(rotation, result + 3, result + 13);
+		}
+
+		blendPosesScalar(_input, _result, i, _end);
+	}
+#endif
+
+	/// Return the blend kernel matching an instruction set
+	BlendKernel			blendKernel(LibMath::InstructionSet _instructionSet)
+	{
+#if LIBMATH_X86
+		switch (_instructionSet)
+		{
+		// The sums are too short for fused multiply-adds to matter, AVX2 uses the AVX kernel
+		case LibMath::InstructionSet::AVX2:
+		case LibMath::InstructionSet::AVX:
+			return blendPosesAVX;
+		case LibMath::InstructionSet::SSE:
+			return blendPosesSSE;
+		default:
+			return blendPosesScalar;
+		}
+#else
+		return blendPosesScalar;
+#endif
+	}
+}
+
+#pragma endregion
+
+/// Blend _poseCount local poses of _boneCount bones in one pass with the active instruction set
+void				blendPoses(const Transform* const* _poses, const float* _weights, size_t _poseCount,
+							   size_t _boneCount, Transform* _result)
+{
+	BlendInput input = { _poses, _weights, _poseCount, _poseCount, 0.f };
+	float weightSum = 0.f;
+
+	for (size_t pose = 0; pose < _poseCount; ++pose)
+	{
+		if (_weights[pose] != 0.f && input.m_referencePose == _poseCount)
+		{
+			input.m_referencePose = pose;
+		}
+
+		weightSum += _weights[pose];
+	}
+
+	assert(weightSum > 0.f);
+
+	input.m_weightScale = 1.f / weightSum;
+
+	blendKernel(LibMath::activeInstructionSet())(input, _result, 0, _boneCount);
+}
+
+/// Blend two local poses, _weight is the weight of the second one, with the rotation interpolation of the clip
+void				blendPoses(const Transform* _first, const Transform* _second, float _weight,
+							   size_t _boneCount, Transform* _result, LibMath::RotationInterpolation _interpolation)
+{
+	if (_interpolation == LibMath::RotationInterpolation::Nlerp)
+	{
+		const Transform* poses[] = { _first, _second };
+		const float weights[] = { 1.f - _weight, _weight };
+
+		blendPoses(poses, weights, 2, _boneCount, _result);
+		return;
+	}
+
+	/*The pose of weight 0 may not have been sampled*/
+	if (_weight <= 0.f || _weight >= 1.f)
+	{
+		const Transform* source = _weight <= 0.f ? _first : _second;
+
+		if (source != _result)
+			std::copy(source, source + _boneCount, _result);
+
+		return;
+	}
+
+	for (size_t i = 0; i < _boneCount; ++i)
+	{
+		Transform const& first = _first[i];
+		Transform const& second = _second[i];
+
+		_result[i].m_position	= LibMath::Vector3::lerpPosition(first.m_position, second.m_position, _weight);
+		_result[i].m_rotation	= LibMath::interpolateRotation(first.m_rotation, second.m_rotation, _weight, _interpolation);
+		_result[i].m_scale		= LibMath::Vector3::lerpScale(first.m_scale, second.m_scale, _weight);
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#pragma region Animation
+
+#include "Transform.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstddef>
+
+#pragma endregion
+
+/// Blend
+// Blend _poseCount local poses of _boneCount bones in one pass with the active instruction set : positions and scales
+// are summed by weight, rotations are summed in the hemisphere of the first pose then normalized. The weights are
+// divided by their sum and the poses of weight 0 are skipped, _result can be one of the poses
+void						blendPoses(const Transform* const* _poses, const float* _weights, size_t _poseCount,
+									   size_t _boneCount, Transform* _result);
+// Blend two local poses, _weight is the weight of the second one. Nlerp runs the blend above, the other rotation
+// interpolations run per bone like the sampling of a clip. A pose of weight 0 is not read
+void						blendPoses(const Transform* _first, const Transform* _second, float _weight,
+									   size_t _boneCount, Transform* _result,
+									   LibMath::RotationInterpolation _interpolation = LibMath::RotationInterpolation::Nlerp);
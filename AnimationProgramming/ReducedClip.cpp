@@ -0,0 +1,323 @@
+#include "ReducedClip.h"
+
+#pragma region Standard
+
+#include <algorithm>
+#include <cmath>
+
+#pragma endregion
+
+namespace
+{
+	const float		g_degreesToRadians = 0.0174532925f;
+
+	/// Interpolation used by the runtime for every channel, the reduction measures its error with the same one
+	LibMath::Quaternion	interpolateValue(LibMath::Quaternion const& _start, LibMath::Quaternion const& _end, float _t,
+										 LibMath::RotationInterpolation _interpolation)
+	{
+		return LibMath::interpolateRotation(_start, _end, _t, _interpolation);
+	}
+
+	LibMath::Vector3	interpolateValue(LibMath::Vector3 const& _start, LibMath::Vector3 const& _end, float _t,
+										 LibMath::RotationInterpolation)
+	{
+		return LibMath::Vector3::lerpPosition(_start, _end, _t);
+	}
+
+	/// Error between a key and its reconstruction, compared with the tolerance of the channel
+	float				valueError(LibMath::Quaternion const& _lhs, LibMath::Quaternion const& _rhs)
+	{
+		/*Angle of the rotation between the two, sin of the half angle is stable for small errors unlike acos*/
+		LibMath::Quaternion difference = LibMath::conjugate(_lhs) * _rhs;
+
+		float sinHalfAngle = std::sqrt(difference.m_b * difference.m_b + difference.m_c * difference.m_c + 
+									   difference.m_d * difference.m_d);
+
+		return 2.f * std::atan2(sinHalfAngle, std::fabs(difference.m_a));
+	}
+
+	float				valueError(LibMath::Vector3 const& _lhs, LibMath::Vector3 const& _rhs)
+	{
+		float x = _lhs.m_x - _rhs.m_x;
+		float y = _lhs.m_y - _rhs.m_y;
+		float z = _lhs.m_z - _rhs.m_z;
+
+		return std::sqrt(x * x + y * y + z * z);
+	}
+
+	/// Append the source key frame of a kept key on one or two bytes
+	template <typename Value>
+	void				pushFrame(ReducedChannel<Value>& _channel, size_t _frame)
+	{
+		_channel.m_frames.push_back(static_cast<uint8_t>(_frame));
+
+		if (_channel.m_hasWideFrames)
+			_channel.m_frames.push_back(static_cast<uint8_t>(_frame >> 8));
+	}
+
+	/// Keep the keys of one track that cannot be rebuilt within tolerance from their neighbours
+	template <typename Value>
+	void				reduceTrack(std::vector<Value> const& _values, float _tolerance, 
+									LibMath::RotationInterpolation _interpolation, ReducedChannel<Value>& _channel)
+	{
+		size_t keyCount = _values.size();
+
+		pushFrame(_channel, 0);
+		_channel.m_values.push_back(_values[0]);
+
+		size_t start = 0;
+
+		while (start + 1 < keyCount)
+		{
+			/*Extend the segment as long as every skipped key is rebuilt within tolerance*/
+			size_t end = start + 1;
+
+			while (end + 1 < keyCount)
+			{
+				size_t candidate = end + 1;
+				bool isWithinTolerance = true;
+
+				for (size_t k = start + 1; k < candidate && isWithinTolerance; ++k)
+				{
+					float t = float(k - start) / float(candidate - start);
+
+					isWithinTolerance = valueError(_values[k], interpolateValue(_values[start], _values[candidate], t, _interpolation)) <= 
+										_tolerance;
+				}
+
+				if (!isWithinTolerance)
+					break;
+
+				end = candidate;
+			}
+
+			/*A constant track keeps only its first key*/
+			bool isConstant = true;
+
+			for (size_t k = start + 1; k <= end && isConstant; ++k)
+			{
+				isConstant = valueError(_values[k], _values[start]) <= _tolerance;
+			}
+
+			if (!(isConstant && end == keyCount - 1 && start == 0))
+			{
+				pushFrame(_channel, end);
+				_channel.m_values.push_back(_values[end]);
+			}
+
+			start = end;
+		}
+	}
+
+	/// Interpolate a track at a fractional source frame, _key is the kept key of the cursor and only moves forward
+	template <typename Value>
+	Value				sampleTrack(ReducedChannel<Value> const& _channel, size_t _track, float _frame, uint32_t& _key,
+									LibMath::RotationInterpolation _interpolation)
+	{
+		uint32_t last = _channel.m_trackOffsets[_track + 1] - 1;
+
+		/*Playing forward crosses one kept key at most per frame*/
+		while (_key < last && float(_channel.frame(_key + 1)) <= _frame)
+		{
+			++_key;
+		}
+
+		if (_key == last)
+			return _channel.m_values[last];
+
+		float start = float(_channel.frame(_key));
+		float t = (_frame - start) / (float(_channel.frame(_key + 1)) - start);
+
+		return interpolateValue(_channel.m_values[_key], _channel.m_values[_key + 1], t, _interpolation);
+	}
+
+	/// Move every track of a channel to its first key
+	template <typename Value>
+	void				resetTrackKeys(ReducedChannel<Value> const& _channel, std::vector<uint32_t>& _keys)
+	{
+		_keys.assign(_channel.m_trackOffsets.begin(), _channel.m_trackOffsets.end() - 1);
+	}
+
+	/// Start an empty channel whose frames fit the key count of the clip
+	template <typename Value>
+	void				clearChannel(ReducedChannel<Value>& _channel, size_t _keyCount)
+	{
+		_channel = ReducedChannel<Value>();
+		_channel.m_hasWideFrames = _keyCount > 256;
+	}
+
+	/// Memory of a channel in bytes
+	template <typename Value>
+	size_t				channelFootprint(ReducedChannel<Value> const& _channel)
+	{
+		return _channel.m_frames.size() * sizeof(uint8_t) + _channel.m_values.size() * sizeof(Value) +
+			   _channel.m_trackOffsets.size() * sizeof(uint32_t);
+	}
+
+	/// Copy the keys of one bone and channel out of the clip, _getKey reads the channel at a key
+	template <typename Value, typename KeyGetter>
+	void				gatherTrack(KeyGetter _getKey, size_t _keyCount, std::vector<Value>& _track)
+	{
+		_track.resize(_keyCount);
+
+		for (size_t j = 0; j < _keyCount; ++j)
+		{
+			_track[j] = _getKey(j);
+		}
+	}
+}
+
+/// Remove the keys rebuilt by interpolation within tolerance, the budget of a bone depends on its place in the hierarchy
+void				ReducedClip::reduce(AnimationClip const& _clip, Skeleton const& _skeleton, 
+										ReductionSettings const& _settings)
+{
+	m_boneCount = _clip.m_boneCount;
+	m_keyCount = _clip.m_keyCount;
+	m_duration = _clip.m_duration;
+	m_rotationInterpolation = _clip.m_rotationInterpolation;
+
+	clearChannel(m_rotations, m_keyCount);
+	clearChannel(m_translations, m_keyCount);
+	clearChannel(m_scales, m_keyCount);
+
+	m_constantPose = _clip.m_constantPose;
+	m_rotationBones.clear();
+	m_translationBones.clear();
+
+	if (m_keyCount == 0)
+		return;
+
+	/*The constant channels are already stored once, only the tracks of the clip are reduced*/
+	m_rotationBones = _clip.m_rotationBones;
+	m_translationBones = _clip.m_translationBones;
+
+	/*Bind pose in object space to measure how far a rotation error travels down the hierarchy*/
+	std::vector<Transform> identityPose(m_boneCount);
+	std::vector<Transform> worldBindPose(m_boneCount);
+
+	for (Transform& transform : identityPose)
+	{
+		transform.m_scale = LibMath::Vector3(1.f, 1.f, 1.f);
+	}
+
+	_skeleton.computeWorldPose(identityPose.data(), worldBindPose.data());
+
+	/*Longest distance from a bone to one of its descendants, and the depth of the deepest chain through it*/
+	std::vector<float> leverArms(m_boneCount, 0.f);
+	std::vector<int> depths(m_boneCount, 1);
+	std::vector<int> chainLengths(m_boneCount, 1);
+
+	for (size_t i = 0; i < m_boneCount; ++i)
+	{
+		int parentIndex = _skeleton.m_parentIndices[i];
+
+		if (parentIndex != -1)
+			depths[i] = depths[parentIndex] + 1;
+	}
+
+	for (size_t i = m_boneCount; i-- > 0;)
+	{
+		chainLengths[i] = std::max(chainLengths[i], depths[i]);
+
+		for (int ancestor = _skeleton.m_parentIndices[i]; ancestor != -1; ancestor = _skeleton.m_parentIndices[ancestor])
+		{
+			float distance = valueError(worldBindPose[i].m_position, worldBindPose[ancestor].m_position);
+
+			leverArms[ancestor] = std::max(leverArms[ancestor], distance);
+			chainLengths[ancestor] = std::max(chainLengths[ancestor], chainLengths[i]);
+		}
+	}
+
+	/*Errors add up along a chain so the position budget is shared by every bone of its longest chain*/
+	auto positionTolerance = [&](size_t _bone) { return _settings.m_positionTolerance / float(chainLengths[_bone]); };
+
+	std::vector<LibMath::Quaternion> rotations;
+	std::vector<LibMath::Vector3> vectors;
+
+	for (uint32_t bone : m_rotationBones)
+	{
+		/*A rotation error moves the farthest descendant by about the lever arm times the angle*/
+		float angularTolerance = _settings.m_angularTolerance * g_degreesToRadians;
+
+		if (leverArms[bone] > 0.f)
+			angularTolerance = std::min(angularTolerance, positionTolerance(bone) / leverArms[bone]);
+
+		m_rotations.m_trackOffsets.push_back(static_cast<uint32_t>(m_rotations.m_values.size()));
+		gatherTrack([&](size_t _key) { return _clip.rotation(_key, bone); }, m_keyCount, rotations);
+		reduceTrack(rotations, angularTolerance, m_rotationInterpolation, m_rotations);
+	}
+
+	for (uint32_t bone : m_translationBones)
+	{
+		m_translations.m_trackOffsets.push_back(static_cast<uint32_t>(m_translations.m_values.size()));
+		gatherTrack([&](size_t _key) { return _clip.translation(_key, bone); }, m_keyCount, vectors);
+		reduceTrack(vectors, positionTolerance(bone), m_rotationInterpolation, m_translations);
+
+		/*A scale error is multiplied by the lever arm like a rotation error*/
+		m_scales.m_trackOffsets.push_back(static_cast<uint32_t>(m_scales.m_values.size()));
+		gatherTrack([&](size_t _key) { return _clip.scale(_key, bone); }, m_keyCount, vectors);
+		reduceTrack(vectors, leverArms[bone] > 0.f ? positionTolerance(bone) / leverArms[bone] : positionTolerance(bone),
+					m_rotationInterpolation, m_scales);
+	}
+
+	m_rotations.m_trackOffsets.push_back(static_cast<uint32_t>(m_rotations.m_values.size()));
+	m_translations.m_trackOffsets.push_back(static_cast<uint32_t>(m_translations.m_values.size()));
+	m_scales.m_trackOffsets.push_back(static_cast<uint32_t>(m_scales.m_values.size()));
+}
+
+/// Move every track of a cursor to its first key
+void				ReducedClip::resetCursor(ReducedClipCursor& _cursor) const
+{
+	resetTrackKeys(m_rotations, _cursor.m_rotationKeys);
+	resetTrackKeys(m_translations, _cursor.m_translationKeys);
+	resetTrackKeys(m_scales, _cursor.m_scaleKeys);
+
+	_cursor.m_frame = 0.f;
+}
+
+/// Interpolate every bone at a time in seconds, clamped to the clip, moving the cursor forward
+void				ReducedClip::sampleTime(float _time, Transform* _pose, ReducedClipCursor& _cursor) const
+{
+	KeyPosition position = findKeyPosition(_time, m_duration, m_keyCount);
+
+	float frame = float(position.m_key) + position.m_t;
+
+	/*A loop or a cursor of another clip starts again from the first keys*/
+	if (frame < _cursor.m_frame || _cursor.m_rotationKeys.size() != m_rotationBones.size() ||
+		_cursor.m_translationKeys.size() != m_translationBones.size())
+	{
+		resetCursor(_cursor);
+	}
+
+	_cursor.m_frame = frame;
+
+	std::copy(m_constantPose.begin(), m_constantPose.end(), _pose);
+
+	for (size_t track = 0; track < m_translationBones.size(); ++track)
+	{
+		Transform& transform = _pose[m_translationBones[track]];
+
+		transform.m_position	= sampleTrack(m_translations, track, frame, _cursor.m_translationKeys[track], m_rotationInterpolation);
+		transform.m_scale		= sampleTrack(m_scales, track, frame, _cursor.m_scaleKeys[track], m_rotationInterpolation);
+	}
+
+	for (size_t track = 0; track < m_rotationBones.size(); ++track)
+	{
+		_pose[m_rotationBones[track]].m_rotation = sampleTrack(m_rotations, track, frame, _cursor.m_rotationKeys[track],
+															   m_rotationInterpolation);
+	}
+}
+
+/// Number of keys kept in every channel
+size_t				ReducedClip::keptKeyCount() const
+{
+	return m_rotations.m_values.size() + m_translations.m_values.size() + m_scales.m_values.size();
+}
+
+/// Memory used by the kept keys, the constant pose and the track tables in bytes
+size_t				ReducedClip::footprint() const
+{
+	return channelFootprint(m_rotations) + channelFootprint(m_translations) + channelFootprint(m_scales) +
+		   m_constantPose.size() * sizeof(Transform) +
+		   (m_rotationBones.size() + m_translationBones.size()) * sizeof(uint32_t);
+}
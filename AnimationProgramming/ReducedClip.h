@@ -0,0 +1,91 @@
+#pragma once
+
+#pragma region Animation
+
+#include "Transform.h"
+#include "AnimationClip.h"
+#include "Skeleton.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstdint>
+#include <vector>
+
+#pragma endregion
+
+/// Tolerances of the keyframe reduction
+struct ReductionSettings
+{
+	float					m_positionTolerance = 0.1f; // Largest position error of a bone in object space
+	float					m_angularTolerance = 0.5f; // Largest local rotation error in degrees
+};
+
+/// Keys of one channel of every animated track, each track keeps its own key frames
+template <typename Value>
+struct ReducedChannel
+{
+	std::vector<uint8_t>	m_frames; // Source key frame of every kept key, increasing inside a track, one byte each when
+									  // the clip has at most 256 keys and two otherwise
+	std::vector<Value>		m_values; // Value of every kept key
+	std::vector<uint32_t>	m_trackOffsets; // First key of every track, one extra offset closes the last track
+
+	bool					m_hasWideFrames = false; // Frames are stored on two bytes
+
+	/// Access
+	// Source key frame of a kept key
+	uint32_t				frame(size_t _key) const
+	{
+		return m_hasWideFrames ? uint32_t(m_frames[_key * 2]) | uint32_t(m_frames[_key * 2 + 1]) << 8 : m_frames[_key];
+	}
+};
+
+/// Kept key starting the current segment of every track of a reduced clip, kept by the caller between two samples so
+/// playing forward steps to the next key instead of searching for it
+struct ReducedClipCursor
+{
+	std::vector<uint32_t>	m_rotationKeys;
+	std::vector<uint32_t>	m_translationKeys;
+	std::vector<uint32_t>	m_scaleKeys;
+
+	float					m_frame = 0.f; // Source frame of the last sample, an earlier frame restarts every track
+};
+
+/// Classified clip whose animated rotation, translation and scale tracks only keep the keys needed to stay within
+/// tolerance, the constant channels are copied from the clip. Offline tooling measured by the reduction benchmark, the
+/// runtime plays the classified clips
+struct ReducedClip
+{
+	ReducedChannel<LibMath::Quaternion>	m_rotations; // One track per rotation track of the clip
+	ReducedChannel<LibMath::Vector3>	m_translations; // One track per translation track of the clip
+	ReducedChannel<LibMath::Vector3>	m_scales; // One track per translation track of the clip
+
+	std::vector<Transform>				m_constantPose; // Channels stored once, the sampler starts from this pose
+	std::vector<uint32_t>				m_rotationBones; // Bone of every rotation track
+	std::vector<uint32_t>				m_translationBones; // Bone of every translation and scale track
+
+	size_t								m_boneCount = 0; // Number of bones
+	size_t								m_keyCount = 0; // Number of keys of the source clip
+
+	float								m_duration = 0.f; // Duration in seconds
+
+	LibMath::RotationInterpolation		m_rotationInterpolation = LibMath::RotationInterpolation::Slerp; // Copied from the source clip
+
+	/// Reduce
+	// Remove the keys rebuilt by interpolation within tolerance, the budget of a bone depends on its place in the hierarchy
+	void					reduce(AnimationClip const& _clip, Skeleton const& _skeleton,
+								   ReductionSettings const& _settings);
+
+	/// Sample
+	// Move every track of a cursor to its first key
+	void					resetCursor(ReducedClipCursor& _cursor) const;
+	// Interpolate every bone at a time in seconds, clamped to the clip, moving the cursor forward
+	void					sampleTime(float _time, Transform* _pose, ReducedClipCursor& _cursor) const;
+
+	/// Memory
+	// Number of keys kept in every channel
+	size_t					keptKeyCount() const;
+	// Memory used by the kept keys, the constant pose and the track tables in bytes
+	size_t					footprint() const;
+};
@@ -0,0 +1,507 @@
+#include "ResourceFile.h"
+
+#pragma region Standard
+
+#include <cstring>
+#include <cmath>
+
+#pragma endregion
+
+#pragma region Platform
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#pragma endregion
+
+namespace
+{
+	/// Read a 32 bits value at an offset, the caller checks the bounds
+	template <typename Type>
+	Type				readValue(const unsigned char* _data, size_t _offset)
+	{
+		Type value;
+		memcpy(&value, _data + _offset, sizeof(Type));
+
+		return value;
+	}
+
+	/// Convert a resource key to a transform
+	Transform			toTransform(ResourceKey const& _key)
+	{
+		Transform result;
+		result.m_position	= LibMath::Vector3(_key.m_position[0], _key.m_position[1], _key.m_position[2]);
+		result.m_rotation	= LibMath::Quaternion(_key.m_rotation[0], _key.m_rotation[1], _key.m_rotation[2], _key.m_rotation[3]);
+		result.m_scale		= LibMath::Vector3(_key.m_scale[0], _key.m_scale[1], _key.m_scale[2]);
+
+		return result;
+	}
+}
+
+#pragma region MappedFile
+
+/// Unmap the file
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+/// Map the whole file, return false if it cannot be opened
+bool				MappedFile::open(const char* _path)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(_path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (mapping == nullptr)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (data == nullptr)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_fileHandle = file;
+	m_mappingHandle = mapping;
+	m_data = static_cast<const unsigned char*>(data);
+	m_size = static_cast<size_t>(size.QuadPart);
+#else
+	int file = ::open(_path, O_RDONLY);
+
+	if (file < 0)
+		return false;
+
+	struct stat status;
+
+	if (fstat(file, &status) != 0 || status.st_size == 0)
+	{
+		::close(file);
+		return false;
+	}
+
+	void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+	/*The mapping stays valid once the descriptor is closed*/
+	::close(file);
+
+	if (data == MAP_FAILED)
+		return false;
+
+	m_data = static_cast<const unsigned char*>(data);
+	m_size = static_cast<size_t>(status.st_size);
+#endif
+
+	return true;
+}
+
+/// Unmap the file
+void				MappedFile::close()
+{
+	if (m_data == nullptr)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_data);
+	CloseHandle(m_mappingHandle);
+	CloseHandle(m_fileHandle);
+
+	m_fileHandle = nullptr;
+	m_mappingHandle = nullptr;
+#else
+	munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+}
+
+#pragma endregion
+
+#pragma region AnimationFile
+
+/// Map the file and check its structure, return false and set the error if it is malformed
+bool				AnimationFile::open(const char* _path)
+{
+	m_tracks.clear();
+	m_keyCount = 0;
+
+	if (!m_file.open(_path))
+	{
+		m_error = std::string("cannot map ") + _path;
+		return false;
+	}
+
+	const unsigned char* data = m_file.data();
+	size_t size = m_file.size();
+
+	if (size < 12)
+	{
+		m_error = "file is too small for the header";
+		return false;
+	}
+
+	m_duration = readValue<float>(data, 0);
+	uint32_t trackCount = readValue<uint32_t>(data, 4);
+
+	/*Every track has at least its 8 bytes header, a corrupt count must not allocate before failing*/
+	if (trackCount > (size - 12) / 8)
+	{
+		m_error = "track count does not fit the file";
+		return false;
+	}
+
+	m_tracks.resize(trackCount);
+
+	size_t offset = 12;
+
+	for (uint32_t i = 0; i < trackCount && offset < size; ++i)
+	{
+		if (offset + 8 > size)
+		{
+			m_error = "truncated track header";
+			return false;
+		}
+
+		uint32_t keyCount = readValue<uint32_t>(data, offset);
+		offset += 8;
+
+		if (keyCount > (size - offset) / sizeof(ResourceKey))
+		{
+			m_error = "truncated track keys";
+			return false;
+		}
+
+		/*Every field is 4 bytes and the mapping is page aligned so the keys can be read in place*/
+		m_tracks[i].m_keys = reinterpret_cast<const ResourceKey*>(data + offset);
+		m_tracks[i].m_keyCount = keyCount;
+
+		m_keyCount = keyCount > m_keyCount ? keyCount : m_keyCount;
+
+		offset += keyCount * sizeof(ResourceKey);
+	}
+
+	if (offset != size)
+	{
+		m_error = "unexpected data after the last track";
+		return false;
+	}
+
+	return true;
+}
+
+/// Check that every key is finite and every rotation is a unit quaternion
+bool				AnimationFile::validate()
+{
+	for (size_t i = 0; i < m_tracks.size(); ++i)
+	{
+		for (uint32_t j = 0; j < m_tracks[i].m_keyCount; ++j)
+		{
+			const float* values = m_tracks[i].m_keys[j].m_position;
+
+			for (size_t k = 0; k < sizeof(ResourceKey) / sizeof(float); ++k)
+			{
+				if (!std::isfinite(values[k]))
+				{
+					m_error = "non finite value in track " + std::to_string(i) + " key " + std::to_string(j);
+					return false;
+				}
+			}
+
+			const float* rotation = m_tracks[i].m_keys[j].m_rotation;
+			float length = rotation[0] * rotation[0] + rotation[1] * rotation[1] + 
+						   rotation[2] * rotation[2] + rotation[3] * rotation[3];
+
+			if (std::fabs(length - 1.f) > 1e-3f)
+			{
+				m_error = "non unit rotation in track " + std::to_string(i) + " key " + std::to_string(j);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/// Return the track of a bone, nullptr if the bone has no key
+AnimationTrack const*	AnimationFile::findTrack(size_t _bone) const
+{
+	/*The root is not animated, the first track belongs to the bone after it*/
+	if (_bone == 0 || _bone > m_tracks.size() || m_tracks[_bone - 1].m_keyCount == 0)
+		return nullptr;
+
+	return &m_tracks[_bone - 1];
+}
+
+/// Get the local transform of a bone at a key relative to the bind pose, identity if the bone has no key
+Transform			AnimationFile::getKey(size_t _bone, size_t _key) const
+{
+	AnimationTrack const* track = findTrack(_bone);
+
+	if (!track)
+	{
+		Transform identity;
+		identity.m_scale = LibMath::Vector3(1.f, 1.f, 1.f);
+
+		return identity;
+	}
+
+	/*Hold the last key if the track is shorter than the clip*/
+	size_t key = _key < track->m_keyCount ? _key : track->m_keyCount - 1;
+
+	return toTransform(track->m_keys[key]);
+}
+
+/// Copy the tracks of the first _boneCount bones into a key-major clip in one pass
+void				AnimationFile::toClip(AnimationClip& _clip, size_t _boneCount) const
+{
+	_clip.resize(_boneCount, m_keyCount);
+	_clip.m_duration = m_duration;
+
+	for (size_t i = 0; i < _boneCount; ++i)
+	{
+		if (!findTrack(i))
+			continue;
+
+		for (size_t j = 0; j < m_keyCount; ++j)
+		{
+			_clip.setKey(j, i, getKey(i, j));
+		}
+	}
+}
+
+#pragma endregion
+
+#pragma region SkeletonFile
+
+/// Map the file and check its structure, return false and set the error if it is malformed
+bool				SkeletonFile::open(const char* _path)
+{
+	m_bones.clear();
+	m_bindTransforms = nullptr;
+
+	if (!m_file.open(_path))
+	{
+		m_error = std::string("cannot map ") + _path;
+		return false;
+	}
+
+	const unsigned char* data = m_file.data();
+	size_t size = m_file.size();
+
+	if (size < 4)
+	{
+		m_error = "file is too small for the header";
+		return false;
+	}
+
+	uint32_t boneCount = readValue<uint32_t>(data, 0);
+
+	/*Every bone has at least its name length, index and parent index*/
+	if (boneCount > (size - 4) / 12)
+	{
+		m_error = "bone count does not fit the file";
+		return false;
+	}
+
+	m_bones.resize(boneCount);
+
+	size_t offset = 4;
+
+	for (uint32_t i = 0; i < boneCount; ++i)
+	{
+		if (offset + 4 > size)
+		{
+			m_error = "truncated bone name";
+			return false;
+		}
+
+		uint32_t nameLength = readValue<uint32_t>(data, offset);
+		offset += 4;
+
+		if (nameLength > size - offset || size - offset - nameLength < 8)
+		{
+			m_error = "truncated bone " + std::to_string(i);
+			return false;
+		}
+
+		m_bones[i].m_name = reinterpret_cast<const char*>(data + offset);
+		m_bones[i].m_nameLength = nameLength;
+		offset += nameLength;
+
+		/*Skip the bone index which is always the position of the bone in the file*/
+		m_bones[i].m_parentIndex = readValue<int32_t>(data, offset + 4);
+		offset += 8;
+
+		if (m_bones[i].m_parentIndex >= static_cast<int32_t>(i))
+		{
+			m_error = "bone " + std::to_string(i) + " is stored before its parent";
+			return false;
+		}
+	}
+
+	if (size - offset != boneCount * sizeof(ResourceKey))
+	{
+		m_error = "bind pose size does not match the bone count";
+		return false;
+	}
+
+	m_bindTransforms = data + offset;
+
+	return true;
+}
+
+/// Return true if the bone name starts with the prefix
+bool				SkeletonFile::hasPrefix(size_t _bone, const char* _prefix) const
+{
+	size_t prefixLength = strlen(_prefix);
+
+	return m_bones[_bone].m_nameLength >= prefixLength && memcmp(m_bones[_bone].m_name, _prefix, prefixLength) == 0;
+}
+
+/// Return the index of a bone by name, -1 if not found
+int					SkeletonFile::findBone(const char* _name) const
+{
+	size_t nameLength = strlen(_name);
+
+	for (size_t i = 0; i < m_bones.size(); ++i)
+	{
+		if (m_bones[i].m_nameLength == nameLength && memcmp(m_bones[i].m_name, _name, nameLength) == 0)
+			return static_cast<int>(i);
+	}
+
+	return -1;
+}
+
+/// Get the bind transform of a bone in component space, as stored in the file
+Transform			SkeletonFile::getComponentBindTransform(size_t _bone) const
+{
+	/*The names have any length so the bind keys may be unaligned*/
+	ResourceKey key;
+	memcpy(&key, m_bindTransforms + _bone * sizeof(ResourceKey), sizeof(ResourceKey));
+
+	return toTransform(key);
+}
+
+/// Get the local bind transform of a bone, relative to its parent
+Transform			SkeletonFile::getBindTransform(size_t _bone) const
+{
+	Transform bind = getComponentBindTransform(_bone);
+	int parentIndex = m_bones[_bone].m_parentIndex;
+
+	if (parentIndex < 0)
+		return bind;
+
+	/*The world pose is composed as local * parent world, so local = world * inverse(parent world)*/
+	return bind * inverse(getComponentBindTransform(parentIndex));
+}
+
+#pragma endregion
+
+#pragma region MeshFile
+
+/// Map the file and check its structure, return false and set the error if it is malformed
+bool				MeshFile::open(const char* _path)
+{
+	m_subMeshes.clear();
+	m_vertices = nullptr;
+	m_vertexCount = 0;
+
+	if (!m_file.open(_path))
+	{
+		m_error = std::string("cannot map ") + _path;
+		return false;
+	}
+
+	const unsigned char* data = m_file.data();
+	size_t size = m_file.size();
+
+	if (size < 16)
+	{
+		m_error = "file is too small for the header";
+		return false;
+	}
+
+	uint32_t vertexCount = readValue<uint32_t>(data, 0);
+
+	if (vertexCount > (size - 16) / sizeof(MeshVertex))
+	{
+		m_error = "truncated vertices";
+		return false;
+	}
+
+	size_t offset = 12 + vertexCount * sizeof(MeshVertex);
+
+	uint32_t subMeshCount = readValue<uint32_t>(data, offset);
+	offset += 4;
+
+	for (uint32_t i = 0; i < subMeshCount; ++i)
+	{
+		if (offset + 4 > size)
+		{
+			m_error = "truncated sub mesh " + std::to_string(i);
+			return false;
+		}
+
+		MeshSubMesh subMesh;
+		subMesh.m_indexCount = readValue<uint32_t>(data, offset);
+		offset += 4;
+
+		if (subMesh.m_indexCount > (size - offset) / 4 || size - offset - subMesh.m_indexCount * 4 < 4)
+		{
+			m_error = "truncated indices of sub mesh " + std::to_string(i);
+			return false;
+		}
+
+		/*Every field is 4 bytes so the indices are aligned in the mapping*/
+		subMesh.m_indices = reinterpret_cast<const uint32_t*>(data + offset);
+
+		for (uint32_t j = 0; j < subMesh.m_indexCount; ++j)
+		{
+			if (subMesh.m_indices[j] >= vertexCount)
+			{
+				m_error = "index out of range in sub mesh " + std::to_string(i);
+				return false;
+			}
+		}
+
+		offset += subMesh.m_indexCount * 4 + 4;
+
+		m_subMeshes.push_back(subMesh);
+	}
+
+	m_vertices = reinterpret_cast<const MeshVertex*>(data + 12);
+	m_vertexCount = vertexCount;
+
+	return true;
+}
+
+#pragma endregion
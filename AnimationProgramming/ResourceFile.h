@@ -0,0 +1,194 @@
+#pragma once
+
+#pragma region Animation
+
+#include "Transform.h"
+#include "AnimationClip.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#pragma endregion
+
+/// Read-only view of a whole file mapped in memory
+class MappedFile
+{
+	/// Variables
+	const unsigned char*	m_data = nullptr; // First byte of the mapping
+	size_t					m_size = 0; // Size of the file in bytes
+
+#ifdef _WIN32
+	void*					m_fileHandle = nullptr; // Handle of the opened file
+	void*					m_mappingHandle = nullptr; // Handle of the file mapping
+#endif
+
+public:
+
+	/// Constructor
+							MappedFile() = default;
+							MappedFile(MappedFile const&) = delete;
+	MappedFile&				operator=(MappedFile const&) = delete;
+
+	/// Destructor
+							~MappedFile();
+
+	/// Open
+	// Map the whole file, return false if it cannot be opened
+	bool					open(const char* _path);
+	// Unmap the file
+	void					close();
+
+	/// Getter
+	const unsigned char*	data() const { return m_data; }
+	size_t					size() const { return m_size; }
+};
+
+/// Key as stored in the resource files : position, rotation (w, x, y, z) and scale
+struct ResourceKey
+{
+	float					m_position[3];
+	float					m_rotation[4];
+	float					m_scale[3];
+};
+
+static_assert(sizeof(ResourceKey) == 10 * sizeof(float), "ResourceKey must match the file layout");
+
+/// Keys of one bone inside a mapped .anim file
+struct AnimationTrack
+{
+	const ResourceKey*		m_keys = nullptr; // First key, points inside the mapping
+	uint32_t				m_keyCount = 0; // Number of keys
+};
+
+/// Little-endian .anim file read in place :
+/// float duration, uint32 track count, uint32 reserved, then for every track
+/// uint32 key count, uint32 reserved and the keys. The root has no track, track i animates bone i + 1
+/// and bones missing at the end of the file have no key
+class AnimationFile
+{
+	/// Variables
+	MappedFile					m_file;
+	std::vector<AnimationTrack>	m_tracks; // One track per bone after the root
+	std::string					m_error; // Reason of the last failure
+
+	float						m_duration = 0.f; // Duration in seconds
+	size_t						m_keyCount = 0; // Highest key count of every track
+
+	/// Getter
+	// Return the track of a bone, nullptr if the bone has no key
+	AnimationTrack const*		findTrack(size_t _bone) const;
+
+public:
+
+	/// Open
+	// Map the file and check its structure, return false and set the error if it is malformed
+	bool						open(const char* _path);
+
+	/// Validate
+	// Check that every key is finite and every rotation is a unit quaternion
+	bool						validate();
+
+	/// Getter
+	float						duration() const { return m_duration; }
+	size_t						trackCount() const { return m_tracks.size(); }
+	size_t						keyCount() const { return m_keyCount; }
+	AnimationTrack const&		track(size_t _track) const { return m_tracks[_track]; }
+	const char*					error() const { return m_error.c_str(); }
+	// Get the local transform of a bone at a key relative to the bind pose, identity if the bone has no key
+	Transform					getKey(size_t _bone, size_t _key) const;
+
+	/// Convert
+	// Copy the tracks of the first _boneCount bones into a key-major clip in one pass
+	void						toClip(AnimationClip& _clip, size_t _boneCount) const;
+};
+
+/// Bone of a mapped .skel file
+struct SkeletonBone
+{
+	const char*				m_name = nullptr; // Name, not null terminated, points inside the mapping
+	uint32_t				m_nameLength = 0; // Length of the name
+	int32_t					m_parentIndex = -1; // -1 if the bone has no parent
+};
+
+/// Little-endian .skel file read in place :
+/// uint32 bone count, then for every bone uint32 name length, the name, uint32 index, int32 parent index,
+/// followed by the component space bind transform of every bone stored as keys, parents before their children
+class SkeletonFile
+{
+	/// Variables
+	MappedFile					m_file;
+	std::vector<SkeletonBone>	m_bones;
+	std::string					m_error; // Reason of the last failure
+
+	const unsigned char*		m_bindTransforms = nullptr; // First bind key, may be unaligned
+
+public:
+
+	/// Open
+	// Map the file and check its structure, return false and set the error if it is malformed
+	bool						open(const char* _path);
+
+	/// Getter
+	size_t						boneCount() const { return m_bones.size(); }
+	SkeletonBone const&			bone(size_t _bone) const { return m_bones[_bone]; }
+	const char*					error() const { return m_error.c_str(); }
+	// Return true if the bone name starts with the prefix
+	bool						hasPrefix(size_t _bone, const char* _prefix) const;
+	// Return the index of a bone by name, -1 if not found
+	int							findBone(const char* _name) const;
+	// Get the bind transform of a bone in component space, as stored in the file
+	Transform					getComponentBindTransform(size_t _bone) const;
+	// Get the local bind transform of a bone, relative to its parent
+	Transform					getBindTransform(size_t _bone) const;
+};
+
+/// Vertex as stored in the .msh files : position, normal, four bone indices stored as floats and their weights
+struct MeshVertex
+{
+	float					m_position[3];
+	float					m_normal[3];
+	float					m_boneIndices[4];
+	float					m_boneWeights[4];
+};
+
+static_assert(sizeof(MeshVertex) == 14 * sizeof(float), "MeshVertex must match the file layout");
+
+/// Indices of one part of a mapped .msh file
+struct MeshSubMesh
+{
+	const uint32_t*			m_indices = nullptr; // Points inside the mapping
+	uint32_t				m_indexCount = 0;
+};
+
+/// Little-endian .msh file read in place :
+/// uint32 vertex count, uint32 vertex format, uint32 reserved, the vertices, then uint32 sub mesh count
+/// and for every sub mesh uint32 index count, the uint32 indices and uint32 reserved
+class MeshFile
+{
+	/// Variables
+	MappedFile					m_file;
+	std::vector<MeshSubMesh>	m_subMeshes;
+	std::string					m_error; // Reason of the last failure
+
+	const MeshVertex*			m_vertices = nullptr; // First vertex, 4 bytes aligned
+	size_t						m_vertexCount = 0;
+
+public:
+
+	/// Open
+	// Map the file and check its structure, return false and set the error if it is malformed
+	bool						open(const char* _path);
+
+	/// Getter
+	const MeshVertex*			vertices() const { return m_vertices; }
+	size_t						vertexCount() const { return m_vertexCount; }
+	size_t						subMeshCount() const { return m_subMeshes.size(); }
+	MeshSubMesh const&			subMesh(size_t _subMesh) const { return m_subMeshes[_subMesh]; }
+	const char*					error() const { return m_error.c_str(); }
+};
@@ -0,0 +1,189 @@
+#include "Skeleton.h"
+
+#pragma region Standard
+
+#include <cassert>
+#include <algorithm>
+
+#pragma endregion
+
+namespace
+{
+	/// Convert up to 64 transforms to matrices by splitting them in component arrays on the stack
+	void			transformToMatrix4Chunk(const Transform* _transforms, LibMath::Matrix4* _matrices, size_t _count)
+	{
+		float components[10][64];
+
+		assert(_count <= 64);
+
+		for (size_t i = 0; i < _count; ++i)
+		{
+			Transform const& transform = _transforms[i];
+
+			components[0][i] = transform.m_position.m_x;
+			components[1][i] = transform.m_position.m_y;
+			components[2][i] = transform.m_position.m_z;
+			components[3][i] = transform.m_rotation.m_a;
+			components[4][i] = transform.m_rotation.m_b;
+			components[5][i] = transform.m_rotation.m_c;
+			components[6][i] = transform.m_rotation.m_d;
+			components[7][i] = transform.m_scale.m_x;
+			components[8][i] = transform.m_scale.m_y;
+			components[9][i] = transform.m_scale.m_z;
+		}
+
+		TransformArrays transforms = 
+		{
+			{ components[0], components[1], components[2] },
+			{ components[3], components[4], components[5], components[6] },
+			{ components[7], components[8], components[9] }
+		};
+
+		/*Several bones at a time with the active instruction set*/
+		transformToMatrix4(transforms, _matrices, _count);
+	}
+}
+
+/// Copy the bind pose and the hierarchy then cache the inverse bind pose matrices
+void				Skeleton::build(std::vector<Transform> const& _localBindPose, std::vector<int> const& _parentIndices)
+{
+	assert(_localBindPose.size() == _parentIndices.size());
+
+	m_boneCount = _localBindPose.size();
+	m_localBindPose = _localBindPose;
+	m_parentIndices = _parentIndices;
+	m_inverseBindPose.resize(m_boneCount);
+	m_inverseBindTransforms.resize(m_boneCount);
+
+	for (std::vector<float>& component : m_bindRotations)
+	{
+		component.resize(m_boneCount);
+	}
+
+	std::vector<Transform> worldBindPose(m_boneCount);
+
+	for (size_t i = 0; i < m_boneCount; ++i)
+	{
+		int parentIndex = m_parentIndices[i];
+
+		/*Parents are stored before their children so one pass is enough*/
+		assert(parentIndex < static_cast<int>(i));
+
+		if (parentIndex == -1)
+		{
+			worldBindPose[i] = m_localBindPose[i];
+		}
+		else
+		{
+			worldBindPose[i] = m_localBindPose[i] * worldBindPose[parentIndex];
+		}
+
+		m_inverseBindPose[i] = transformToMatrix4(worldBindPose[i]).GetAffineInverse();
+		m_inverseBindTransforms[i] = inverse(worldBindPose[i]);
+
+		m_bindRotations[0][i] = m_localBindPose[i].m_rotation.m_a;
+		m_bindRotations[1][i] = m_localBindPose[i].m_rotation.m_b;
+		m_bindRotations[2][i] = m_localBindPose[i].m_rotation.m_c;
+		m_bindRotations[3][i] = m_localBindPose[i].m_rotation.m_d;
+	}
+}
+
+/// Combine local transforms, relative to their parent, with the hierarchy in one parent before child pass
+void				composeWorldPose(const Transform* _localPose, const int* _parentIndices, size_t _boneCount,
+									 Transform* _worldPose)
+{
+	for (size_t i = 0; i < _boneCount; ++i)
+	{
+		int parentIndex = _parentIndices[i];
+
+		/*The parent is already in world space because it is stored before its children*/
+		_worldPose[i] = parentIndex != -1 ? _localPose[i] * _worldPose[parentIndex] : _localPose[i];
+	}
+}
+
+/// Combine an animated local pose, relative to the bind pose, with the hierarchy
+void				Skeleton::computeWorldPose(const Transform* _localPose, Transform* _worldPose) const
+{
+	/*Bones are processed by chunks so the component arrays stay on the stack*/
+	const size_t chunkSize = 64;
+
+	float positionX[chunkSize];
+	float positionY[chunkSize];
+	float positionZ[chunkSize];
+
+	for (size_t first = 0; first < m_boneCount; first += chunkSize)
+	{
+		size_t count = std::min(chunkSize, m_boneCount - first);
+
+		/*The animation keys are relative to the bind pose, which does not depend on the hierarchy*/
+		for (size_t i = 0; i < count; ++i)
+		{
+			positionX[i] = _localPose[first + i].m_position.m_x;
+			positionY[i] = _localPose[first + i].m_position.m_y;
+			positionZ[i] = _localPose[first + i].m_position.m_z;
+		}
+
+		LibMath::QuaternionArrays bindRotations = { m_bindRotations[0].data() + first, m_bindRotations[1].data() + first,
+													m_bindRotations[2].data() + first, m_bindRotations[3].data() + first };
+		LibMath::Vector3Arrays positions = { positionX, positionY, positionZ };
+
+		LibMath::rotate(bindRotations, positions, positions, count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			Transform const& local = _localPose[first + i];
+			Transform const& bind = m_localBindPose[first + i];
+			Transform& world = _worldPose[first + i];
+
+			world.m_position = LibMath::Vector3(positionX[i], positionY[i], positionZ[i]) * bind.m_scale + bind.m_position;
+			world.m_rotation = bind.m_rotation * local.m_rotation;
+			world.m_scale = local.m_scale * bind.m_scale;
+		}
+	}
+
+	/*The bind relative transforms are now relative to the parents, one pass places them in world space*/
+	composeWorldPose(_worldPose, m_parentIndices.data(), m_boneCount, _worldPose);
+}
+
+/// Convert a world pose to skinning matrices
+void				Skeleton::computeSkinningPalette(const Transform* _worldPose, LibMath::Matrix4* _palette) const
+{
+	const size_t chunkSize = 64;
+
+	for (size_t first = 0; first < m_boneCount; first += chunkSize)
+	{
+		transformToMatrix4Chunk(_worldPose + first, _palette + first, std::min(chunkSize, m_boneCount - first));
+	}
+
+	/*Place the vertices in bone space then apply the animated bones*/
+	LibMath::multiply(m_inverseBindPose.data(), _palette, _palette, m_boneCount);
+}
+
+/// Convert a world pose to affine skinning matrices
+void				Skeleton::computeSkinningPalette(const Transform* _worldPose, AffineMatrix* _palette) const
+{
+	const size_t chunkSize = 64;
+
+	LibMath::Matrix4 palette[chunkSize];
+
+	for (size_t first = 0; first < m_boneCount; first += chunkSize)
+	{
+		size_t count = std::min(chunkSize, m_boneCount - first);
+
+		/*The inverse bind pose is a Matrix4 so the product is made before dropping the last column*/
+		transformToMatrix4Chunk(_worldPose + first, palette, count);
+		LibMath::multiply(m_inverseBindPose.data() + first, palette, palette, count);
+
+		toAffinePalette(palette, _palette + first, count);
+	}
+}
+
+/// Convert a world pose to dual quaternions without going through matrices
+void				Skeleton::computeSkinningPalette(const Transform* _worldPose, DualQuaternion* _palette) const
+{
+	for (size_t i = 0; i < m_boneCount; ++i)
+	{
+		/*Same product as the inverse bind matrix times the bone matrix, made on the rotation and the translation*/
+		_palette[i] = toDualQuaternion(m_inverseBindTransforms[i] * _worldPose[i]);
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#pragma region Animation
+
+#include "Transform.h"
+#include "Skinning.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <vector>
+
+#pragma endregion
+
+#pragma region LibMath
+
+#include "LibMath/Header/Matrix/Matrix4.h"
+
+#pragma endregion
+
+/// Combine local transforms, relative to their parent, with the hierarchy in one parent before child pass, in place if the poses are the same
+void						composeWorldPose(const Transform* _localPose, const int* _parentIndices, size_t _boneCount,
+											 Transform* _worldPose);
+
+/// Bind pose and hierarchy shared read-only by every character using the skeleton
+struct Skeleton
+{
+	std::vector<Transform>			m_localBindPose; // Local bind transform of every bone
+	std::vector<int>				m_parentIndices; // Parent of every bone, -1 for the root, always lower than the bone
+	std::vector<LibMath::Matrix4>	m_inverseBindPose; // Inverse of the world bind transform of every bone
+	std::vector<Transform>			m_inverseBindTransforms; // Same as the inverse bind pose, kept as transforms
+	std::vector<float>				m_bindRotations[4]; // Local bind rotations as w, x, y and z arrays for the batched rotate
+
+	size_t							m_boneCount = 0; // Number of bones
+
+	/// Initialize
+	// Copy the bind pose and the hierarchy then cache the inverse bind pose matrices
+	void					build(std::vector<Transform> const& _localBindPose, std::vector<int> const& _parentIndices);
+
+	/// Evaluate
+	// Combine an animated local pose, relative to the bind pose, with the hierarchy
+	void					computeWorldPose(const Transform* _localPose, Transform* _worldPose) const;
+	// Convert a world pose to skinning matrices
+	void					computeSkinningPalette(const Transform* _worldPose, LibMath::Matrix4* _palette) const;
+	// Convert a world pose to affine skinning matrices
+	void					computeSkinningPalette(const Transform* _worldPose, AffineMatrix* _palette) const;
+	// Convert a world pose to dual quaternions without going through matrices
+	void					computeSkinningPalette(const Transform* _worldPose, DualQuaternion* _palette) const;
+};
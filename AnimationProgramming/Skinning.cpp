@@ -0,0 +1,475 @@
+#include "Skinning.h"
+
+#pragma region Resource
+
+#include "ResourceFile.h"
+
+#pragma endregion
+
+#pragma region Animation
+
+#include "ThreadPool.h"
+
+#pragma endregion
+
+#pragma region LibMath
+
+#include "LibMath/Header/SIMD.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cmath>
+
+#pragma endregion
+
+#if LIBMATH_X86
+#include <immintrin.h>
+#endif
+
+#pragma region Skinning kernels
+
+namespace
+{
+	/// Signature shared by every batched skinning kernel
+	typedef void (*SkinningKernel)(const MeshVertex*, const LibMath::Matrix4*, LibMath::Vector3Arrays const&, 
+								   size_t, size_t);
+
+	/// Skin the vertices from _begin to _end one at a time
+	void				skinVerticesScalar(const MeshVertex* _vertices, const LibMath::Matrix4* _palette,
+										   LibMath::Vector3Arrays const& _positions, size_t _begin, size_t _end)
+	{
+		for (size_t i = _begin; i < _end; ++i)
+		{
+			LibMath::Vector3 position = skinVertex(_vertices[i], _palette);
+
+			_positions.m_x[i] = position.m_x;
+			_positions.m_y[i] = position.m_y;
+			_positions.m_z[i] = position.m_z;
+		}
+	}
+
+	/// Weights of the four influences divided by their sum, as skinning.vs does
+	void				normalizedWeights(MeshVertex const& _vertex, float _weights[4])
+	{
+		float scalar = 1.f / (_vertex.m_boneWeights[0] + _vertex.m_boneWeights[1] + 
+							  _vertex.m_boneWeights[2] + _vertex.m_boneWeights[3]);
+
+		for (int influence = 0; influence < 4; ++influence)
+		{
+			_weights[influence] = scalar * _vertex.m_boneWeights[influence];
+		}
+	}
+
+#if LIBMATH_X86
+	/// Skin one vertex at a time, a register holds one row of the blended matrix
+	void				skinVerticesSSE(const MeshVertex* _vertices, const LibMath::Matrix4* _palette,
+										LibMath::Vector3Arrays const& _positions, size_t _begin, size_t _end)
+	{
+		alignas(16) float position[4];
+
+		for (size_t i = _begin; i < _end; ++i)
+		{
+			MeshVertex const& vertex = _vertices[i];
+
+			float weights[4];
+			normalizedWeights(vertex, weights);
+
+			__m128 rows[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+
+			for (int influence = 0; influence < 4; ++influence)
+			{
+				__m128 weight = _mm_set1_ps(weights[influence]);
+				LibMath::Matrix4 const& matrix = _palette[int(vertex.m_boneIndices[influence])];
+
+				for (int row = 0; row < 4; ++row)
+				{
+					rows[row] = _mm_add_ps(rows[row], _mm_mul_ps(weight, _mm_loadu_ps(matrix.m_matrix[row])));
+				}
+			}
+
+			/*Row vector times the blended matrix, the last column is ignored*/
+			__m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(vertex.m_position[0]), rows[0]), 
+												  _mm_mul_ps(_mm_set1_ps(vertex.m_position[1]), rows[1])),
+									   _mm_add_ps(_mm_mul_ps(_mm_set1_ps(vertex.m_position[2]), rows[2]), rows[3]));
+
+			_mm_store_ps(position, result);
+
+			_positions.m_x[i] = position[0];
+			_positions.m_y[i] = position[1];
+			_positions.m_z[i] = position[2];
+		}
+	}
+
+	/// Put a value of the first vertex in the low lane and one of the second vertex in the high lane
+	LIBMATH_TARGET_AVX
+	__m256				pairAVX(__m128 _first, __m128 _second)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_first), _second, 1);
+	}
+
+	/// Store the positions of two vertices skinned side by side
+	LIBMATH_TARGET_AVX
+	void				storePairAVX(__m256 _result, LibMath::Vector3Arrays const& _positions, size_t _index)
+	{
+		alignas(32) float positions[8];
+		_mm256_store_ps(positions, _result);
+
+		_positions.m_x[_index] = positions[0];
+		_positions.m_y[_index] = positions[1];
+		_positions.m_z[_index] = positions[2];
+		_positions.m_x[_index + 1] = positions[4];
+		_positions.m_y[_index + 1] = positions[5];
+		_positions.m_z[_index + 1] = positions[6];
+	}
+
+	/// Skin two vertices at a time, each 128 bits lane holds one row of the blended matrix of a vertex
+	LIBMATH_TARGET_AVX
+	void				skinVerticesAVX(const MeshVertex* _vertices, const LibMath::Matrix4* _palette,
+										LibMath::Vector3Arrays const& _positions, size_t _begin, size_t _end)
+	{
+		size_t i = _begin;
+
+		for (; i + 2 <= _end; i += 2)
+		{
+			MeshVertex const& first = _vertices[i];
+			MeshVertex const& second = _vertices[i + 1];
+
+			float firstWeights[4];
+			float secondWeights[4];
+			normalizedWeights(first, firstWeights);
+			normalizedWeights(second, secondWeights);
+
+			__m256 rows[4] = { _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps() };
+
+			for (int influence = 0; influence < 4; ++influence)
+			{
+				__m256 weight = pairAVX(_mm_set1_ps(firstWeights[influence]), _mm_set1_ps(secondWeights[influence]));
+				LibMath::Matrix4 const& firstMatrix = _palette[int(first.m_boneIndices[influence])];
+				LibMath::Matrix4 const& secondMatrix = _palette[int(second.m_boneIndices[influence])];
+
+				for (int row = 0; row < 4; ++row)
+				{
+					__m256 matrixRow = pairAVX(_mm_loadu_ps(firstMatrix.m_matrix[row]), 
+													   _mm_loadu_ps(secondMatrix.m_matrix[row]));
+					rows[row] = _mm256_add_ps(rows[row], _mm256_mul_ps(weight, matrixRow));
+				}
+			}
+
+			__m256 x = pairAVX(_mm_set1_ps(first.m_position[0]), _mm_set1_ps(second.m_position[0]));
+			__m256 y = pairAVX(_mm_set1_ps(first.m_position[1]), _mm_set1_ps(second.m_position[1]));
+			__m256 z = pairAVX(_mm_set1_ps(first.m_position[2]), _mm_set1_ps(second.m_position[2]));
+
+			__m256 result = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, rows[0]), _mm256_mul_ps(y, rows[1])),
+										  _mm256_add_ps(_mm256_mul_ps(z, rows[2]), rows[3]));
+
+			storePairAVX(result, _positions, i);
+		}
+
+		skinVerticesScalar(_vertices, _palette, _positions, i, _end);
+	}
+
+	/// Skin two vertices at a time like the AVX kernel with fused multiply-adds
+	LIBMATH_TARGET_AVX2
+	void				skinVerticesAVX2(const MeshVertex* _vertices, const LibMath::Matrix4* _palette,
+										 LibMath::Vector3Arrays const& _positions, size_t _begin, size_t _end)
+	{
+		size_t i = _begin;
+
+		for (; i + 2 <= _end; i += 2)
+		{
+			MeshVertex const& first = _vertices[i];
+			MeshVertex const& second = _vertices[i + 1];
+
+			float firstWeights[4];
+			float secondWeights[4];
+			normalizedWeights(first, firstWeights);
+			normalizedWeights(second, secondWeights);
+
+			__m256 rows[4] = { _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps() };
+
+			for (int influence = 0; influence < 4; ++influence)
+			{
+				__m256 weight = pairAVX(_mm_set1_ps(firstWeights[influence]), _mm_set1_ps(secondWeights[influence]));
+				LibMath::Matrix4 const& firstMatrix = _palette[int(first.m_boneIndices[influence])];
+				LibMath::Matrix4 const& secondMatrix = _palette[int(second.m_boneIndices[influence])];
+
+				for (int row = 0; row < 4; ++row)
+				{
+					__m256 matrixRow = pairAVX(_mm_loadu_ps(firstMatrix.m_matrix[row]), 
+													   _mm_loadu_ps(secondMatrix.m_matrix[row]));
+					rows[row] = _mm256_fmadd_ps(weight, matrixRow, rows[row]);
+				}
+			}
+
+			__m256 x = pairAVX(_mm_set1_ps(first.m_position[0]), _mm_set1_ps(second.m_position[0]));
+			__m256 y = pairAVX(_mm_set1_ps(first.m_position[1]), _mm_set1_ps(second.m_position[1]));
+			__m256 z = pairAVX(_mm_set1_ps(first.m_position[2]), _mm_set1_ps(second.m_position[2]));
+
+			__m256 result = _mm256_fmadd_ps(x, rows[0], _mm256_fmadd_ps(y, rows[1], _mm256_fmadd_ps(z, rows[2], rows[3])));
+
+			storePairAVX(result, _positions, i);
+		}
+
+		skinVerticesScalar(_vertices, _palette, _positions, i, _end);
+	}
+#endif
+
+	/// Return the skinning kernel matching an instruction set
+	SkinningKernel		skinningKernel(LibMath::InstructionSet _instructionSet)
+	{
+#if LIBMATH_X86
+		switch (_instructionSet)
+		{
+		case LibMath::InstructionSet::AVX2:
+			return skinVerticesAVX2;
+		case LibMath::InstructionSet::AVX:
+			return skinVerticesAVX;
+		case LibMath::InstructionSet::SSE:
+			return skinVerticesSSE;
+		default:
+			return skinVerticesScalar;
+		}
+#else
+		return skinVerticesScalar;
+#endif
+	}
+}
+
+#pragma endregion
+
+namespace
+{
+	/// Size of the palette entry of one bone in floats
+	size_t			floatsPerBone(PaletteFormat _format)
+	{
+		switch (_format)
+		{
+		case PaletteFormat::Affine:
+			return 12;
+		case PaletteFormat::DualQuaternion:
+			return 8;
+		default:
+			return 16;
+		}
+	}
+}
+
+/// Build the dual quaternion of the rotation and the translation of a transform, the scale is dropped
+DualQuaternion		toDualQuaternion(Transform const& _transform)
+{
+	LibMath::Quaternion const& rotation = _transform.m_rotation;
+	LibMath::Vector3 const& position = _transform.m_position;
+
+	/*dual = 0.5 * (0, position) * rotation*/
+	DualQuaternion result = 
+	{
+		{ rotation.m_a, rotation.m_b, rotation.m_c, rotation.m_d },
+		{
+			-0.5f * (position.m_x * rotation.m_b + position.m_y * rotation.m_c + position.m_z * rotation.m_d),
+			 0.5f * (position.m_x * rotation.m_a + position.m_y * rotation.m_d - position.m_z * rotation.m_c),
+			 0.5f * (position.m_y * rotation.m_a + position.m_z * rotation.m_b - position.m_x * rotation.m_d),
+			 0.5f * (position.m_z * rotation.m_a + position.m_x * rotation.m_c - position.m_y * rotation.m_b)
+		}
+	};
+
+	return result;
+}
+
+/// Keep the three first columns of a matrix as the rows of an affine matrix
+AffineMatrix		toAffineMatrix(LibMath::Matrix4 const& _matrix)
+{
+	AffineMatrix result;
+
+	for (int row = 0; row < 3; ++row)
+	{
+		for (int column = 0; column < 4; ++column)
+		{
+			result.m_matrix[row][column] = _matrix.m_matrix[column][row];
+		}
+	}
+
+	return result;
+}
+
+/// Convert _count skinning matrices to affine matrices
+void				toAffinePalette(const LibMath::Matrix4* _palette, AffineMatrix* _affinePalette, size_t _count)
+{
+	for (size_t i = 0; i < _count; ++i)
+	{
+		_affinePalette[i] = toAffineMatrix(_palette[i]);
+	}
+}
+
+/// Number of matrices to allocate for _boneCount bones so the palette is a whole number of Matrix4
+size_t				paletteCapacity(PaletteFormat _format, size_t _boneCount)
+{
+	/*Four affine matrices take the place of three Matrix4 and two dual quaternions of one*/
+	size_t bonesPerBlock = 1;
+
+	if (_format == PaletteFormat::Affine)
+		bonesPerBlock = 4;
+	else if (_format == PaletteFormat::DualQuaternion)
+		bonesPerBlock = 2;
+
+	return (_boneCount + bonesPerBlock - 1) / bonesPerBlock * bonesPerBlock;
+}
+
+/// Count to give SetSkinningPose, which copies 16 floats per count, to send the palette of _boneCount bones
+size_t				paletteSubmitCount(PaletteFormat _format, size_t _boneCount)
+{
+	return paletteCapacity(_format, _boneCount) * floatsPerBone(_format) / 16;
+}
+
+/// Size in bytes of the palette of _boneCount bones
+size_t				paletteSize(PaletteFormat _format, size_t _boneCount)
+{
+	return paletteCapacity(_format, _boneCount) * floatsPerBone(_format) * sizeof(float);
+}
+
+/// Return the name of a palette format
+const char*			paletteFormatName(PaletteFormat _format)
+{
+	switch (_format)
+	{
+	case PaletteFormat::Affine:
+		return "affine 3x4";
+	case PaletteFormat::DualQuaternion:
+		return "dual quaternion";
+	default:
+		return "Matrix4";
+	}
+}
+
+/// Skin a vertex on the CPU the way skinning.vs does
+LibMath::Vector3	skinVertex(MeshVertex const& _vertex, const LibMath::Matrix4* _palette)
+{
+	float scalar = 1.f / (_vertex.m_boneWeights[0] + _vertex.m_boneWeights[1] + 
+						  _vertex.m_boneWeights[2] + _vertex.m_boneWeights[3]);
+
+	/*Blend the matrices then transform the position as a row vector*/
+	float blended[4][3] = {};
+
+	for (int influence = 0; influence < 4; ++influence)
+	{
+		float weight = scalar * _vertex.m_boneWeights[influence];
+		LibMath::Matrix4 const& matrix = _palette[int(_vertex.m_boneIndices[influence])];
+
+		for (int row = 0; row < 4; ++row)
+		{
+			for (int column = 0; column < 3; ++column)
+			{
+				blended[row][column] += weight * matrix.m_matrix[row][column];
+			}
+		}
+	}
+
+	float position[3];
+
+	for (int column = 0; column < 3; ++column)
+	{
+		position[column] = _vertex.m_position[0] * blended[0][column] + _vertex.m_position[1] * blended[1][column] +
+						   _vertex.m_position[2] * blended[2][column] + blended[3][column];
+	}
+
+	return LibMath::Vector3(position[0], position[1], position[2]);
+}
+
+/// Skin a vertex on the CPU the way skinning_affine.vs does
+LibMath::Vector3	skinVertex(MeshVertex const& _vertex, const AffineMatrix* _palette)
+{
+	float scalar = 1.f / (_vertex.m_boneWeights[0] + _vertex.m_boneWeights[1] + 
+						  _vertex.m_boneWeights[2] + _vertex.m_boneWeights[3]);
+
+	/*Blend the rows then take one dot product per coordinate*/
+	float blended[3][4] = {};
+
+	for (int influence = 0; influence < 4; ++influence)
+	{
+		float weight = scalar * _vertex.m_boneWeights[influence];
+		AffineMatrix const& matrix = _palette[int(_vertex.m_boneIndices[influence])];
+
+		for (int row = 0; row < 3; ++row)
+		{
+			for (int column = 0; column < 4; ++column)
+			{
+				blended[row][column] += weight * matrix.m_matrix[row][column];
+			}
+		}
+	}
+
+	float position[3];
+
+	for (int row = 0; row < 3; ++row)
+	{
+		position[row] = blended[row][0] * _vertex.m_position[0] + blended[row][1] * _vertex.m_position[1] +
+						blended[row][2] * _vertex.m_position[2] + blended[row][3];
+	}
+
+	return LibMath::Vector3(position[0], position[1], position[2]);
+}
+
+/// Skin a vertex on the CPU the way skinning_dq.vs does
+LibMath::Vector3	skinVertex(MeshVertex const& _vertex, const DualQuaternion* _palette)
+{
+	DualQuaternion const& first = _palette[int(_vertex.m_boneIndices[0])];
+
+	float real[4] = {};
+	float dual[4] = {};
+
+	for (int influence = 0; influence < 4; ++influence)
+	{
+		DualQuaternion const& bone = _palette[int(_vertex.m_boneIndices[influence])];
+
+		/*Blend on the hemisphere of the first bone so opposite quaternions of the same rotation do not cancel*/
+		float hemisphere = first.m_real[0] * bone.m_real[0] + first.m_real[1] * bone.m_real[1] + 
+						   first.m_real[2] * bone.m_real[2] + first.m_real[3] * bone.m_real[3];
+		float weight = hemisphere < 0.f ? -_vertex.m_boneWeights[influence] : _vertex.m_boneWeights[influence];
+
+		for (int i = 0; i < 4; ++i)
+		{
+			real[i] += weight * bone.m_real[i];
+			dual[i] += weight * bone.m_dual[i];
+		}
+	}
+
+	/*Normalizing by the real part also removes the weight sum*/
+	float invLength = 1.f / std::sqrt(real[0] * real[0] + real[1] * real[1] + real[2] * real[2] + real[3] * real[3]);
+
+	LibMath::Quaternion rotation(real[0] * invLength, real[1] * invLength, real[2] * invLength, real[3] * invLength);
+
+	for (float& component : dual)
+	{
+		component *= invLength;
+	}
+
+	/*translation = 2 * dual * conjugate(real)*/
+	LibMath::Vector3 translation(
+		2.f * (rotation.m_a * dual[1] - dual[0] * rotation.m_b + rotation.m_c * dual[3] - rotation.m_d * dual[2]),
+		2.f * (rotation.m_a * dual[2] - dual[0] * rotation.m_c + rotation.m_d * dual[1] - rotation.m_b * dual[3]),
+		2.f * (rotation.m_a * dual[3] - dual[0] * rotation.m_d + rotation.m_b * dual[2] - rotation.m_c * dual[1]));
+
+	LibMath::Vector3 position(_vertex.m_position[0], _vertex.m_position[1], _vertex.m_position[2]);
+
+	return LibMath::rotate(rotation, position) + translation;
+}
+
+/// Skin _count vertices with the four influences of skinning.vs and write the positions as arrays
+void				skinVertices(const MeshVertex* _vertices, size_t _count, const LibMath::Matrix4* _palette,
+								 LibMath::Vector3Arrays const& _positions)
+{
+	skinningKernel(LibMath::activeInstructionSet())(_vertices, _palette, _positions, 0, _count);
+}
+
+/// Skin the vertices on the pool in chunks of _grainSize and wait for them
+void				skinVertices(const MeshVertex* _vertices, size_t _count, const LibMath::Matrix4* _palette,
+								 LibMath::Vector3Arrays const& _positions, ThreadPool& _pool, size_t _grainSize)
+{
+	SkinningKernel kernel = skinningKernel(LibMath::activeInstructionSet());
+
+	_pool.parallelFor(_count, _grainSize, [=](size_t _begin, size_t _end)
+	{
+		kernel(_vertices, _palette, _positions, _begin, _end);
+	});
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#pragma region Animation
+
+#include "Transform.h"
+
+#pragma endregion
+
+#pragma region LibMath
+
+#include "LibMath/Header/Matrix/Matrix4.h"
+#include "LibMath/Header/Vector/Vector3.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstddef>
+
+#pragma endregion
+
+struct MeshVertex;
+class ThreadPool;
+
+/// Layout of the skinning palette sent with SetSkinningPose
+enum class PaletteFormat
+{
+	Matrix4, // Row-major 4x4 matrices, 64 bytes per bone, read by skinning.vs
+	Affine, // 3x4 affine matrices, 48 bytes per bone, read by skinning_affine.vs
+	DualQuaternion // Unit dual quaternions, 32 bytes per bone, read by skinning_dq.vs
+};
+
+/// Skinning matrix without the constant (0, 0, 0, 1) column of a Matrix4 :
+/// every row is a column of the Matrix4, so a shader skins with three dot products and the translation is last
+struct AffineMatrix
+{
+	alignas(16) float		m_matrix[3][4];
+};
+
+/// Rigid skinning transform : the rotation as the real part, half the translation times the rotation as the dual part.
+/// Blending dual quaternions keeps the volume of twisted joints where blending matrices collapses it
+struct DualQuaternion
+{
+	float					m_real[4]; // w, x, y, z
+	float					m_dual[4]; // w, x, y, z
+};
+
+/// Convert
+// Build the dual quaternion of the rotation and the translation of a transform, the scale is dropped
+DualQuaternion				toDualQuaternion(Transform const& _transform);
+// Keep the three first columns of a matrix as the rows of an affine matrix
+AffineMatrix				toAffineMatrix(LibMath::Matrix4 const& _matrix);
+// Convert _count skinning matrices to affine matrices
+void						toAffinePalette(const LibMath::Matrix4* _palette, AffineMatrix* _affinePalette, size_t _count);
+
+/// Size
+// Number of matrices to allocate for _boneCount bones so the palette is a whole number of Matrix4
+size_t						paletteCapacity(PaletteFormat _format, size_t _boneCount);
+// Count to give SetSkinningPose, which copies 16 floats per count, to send the palette of _boneCount bones
+size_t						paletteSubmitCount(PaletteFormat _format, size_t _boneCount);
+// Size in bytes of the palette of _boneCount bones
+size_t						paletteSize(PaletteFormat _format, size_t _boneCount);
+// Return the name of a palette format
+const char*					paletteFormatName(PaletteFormat _format);
+
+/// Reference
+// Skin a vertex on the CPU the way skinning.vs does
+LibMath::Vector3			skinVertex(MeshVertex const& _vertex, const LibMath::Matrix4* _palette);
+// Skin a vertex on the CPU the way skinning_affine.vs does
+LibMath::Vector3			skinVertex(MeshVertex const& _vertex, const AffineMatrix* _palette);
+// Skin a vertex on the CPU the way skinning_dq.vs does
+LibMath::Vector3			skinVertex(MeshVertex const& _vertex, const DualQuaternion* _palette);
+
+/// Batch
+// Skin _count vertices with the four influences of skinning.vs and write the positions as arrays
+void						skinVertices(const MeshVertex* _vertices, size_t _count, const LibMath::Matrix4* _palette,
+										 LibMath::Vector3Arrays const& _positions);
+// Skin the vertices on the pool in chunks of _grainSize and wait for them
+void						skinVertices(const MeshVertex* _vertices, size_t _count, const LibMath::Matrix4* _palette,
+										 LibMath::Vector3Arrays const& _positions, ThreadPool& _pool, 
+										 size_t _grainSize = 2048);
@@ -0,0 +1,212 @@
+#include "SyncGroup.h"
+
+#pragma region Standard
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+#pragma endregion
+
+namespace
+{
+	/// Part of the height range of a foot above its lowest key where it can touch the ground
+	const float			g_contactHeightRatio = 0.2f;
+	/// Part of the largest vertical speed of a foot under which it can touch the ground
+	const float			g_contactSpeedRatio = 0.4f;
+	/// Part of the cycle between the left and the right plant that a walk or a run can have
+	const float			g_minimumStepRatio = 0.3f;
+	const float			g_maximumStepRatio = 0.7f;
+
+	/// Bring a phase back between 0 and 1
+	float				wrapPhase(float _phase)
+	{
+		return _phase - std::floor(_phase);
+	}
+
+	/// Return the first key of the longest run of contact keys of a cycle, the key count if the foot never lands
+	size_t				findTouchDown(std::vector<bool> const& _contacts)
+	{
+		const size_t keyCount = _contacts.size();
+
+		size_t touchDown = keyCount;
+		size_t longestLength = 0;
+
+		for (size_t j = 0; j < keyCount; ++j)
+		{
+			/*A run starts on a contact key after a key in the air, a foot always on the ground has no plant*/
+			if (!_contacts[j] || _contacts[(j + keyCount - 1) % keyCount])
+				continue;
+
+			size_t length = 0;
+
+			while (length < keyCount && _contacts[(j + length) % keyCount])
+			{
+				++length;
+			}
+
+			if (length > longestLength)
+			{
+				longestLength = length;
+				touchDown = j;
+			}
+		}
+
+		return touchDown;
+	}
+}
+
+/// Place a foot plant marker on the key where each foot lands : low along _up and barely moving along _up, the clip
+/// must be one cycle
+void				detectFootPlants(AnimationClip& _clip, Skeleton const& _skeleton, size_t _leftFoot,
+									 size_t _rightFoot, LibMath::Vector3 const& _up)
+{
+	_clip.m_syncMarkers.clear();
+
+	if (_clip.m_keyCount < 3)
+		return;
+
+	/*The last key repeats the first one to close the cycle*/
+	const size_t cycleKeyCount = _clip.m_keyCount - 1;
+	const size_t feet[] = { _leftFoot, _rightFoot };
+
+	std::vector<Transform> localPose(_skeleton.m_boneCount);
+	std::vector<Transform> worldPose(_skeleton.m_boneCount);
+	std::vector<float> heights[2] = { std::vector<float>(cycleKeyCount), std::vector<float>(cycleKeyCount) };
+
+	for (size_t j = 0; j < cycleKeyCount; ++j)
+	{
+		_clip.sampleKey(j, localPose.data());
+		_skeleton.computeWorldPose(localPose.data(), worldPose.data());
+
+		for (size_t foot = 0; foot < 2; ++foot)
+		{
+			LibMath::Vector3 const& position = worldPose[feet[foot]].m_position;
+
+			heights[foot][j] = position.m_x * _up.m_x + position.m_y * _up.m_y + position.m_z * _up.m_z;
+		}
+	}
+
+	for (size_t foot = 0; foot < 2; ++foot)
+	{
+		std::vector<float> const& height = heights[foot];
+		std::vector<float> speeds(cycleKeyCount);
+
+		/*The clips are played in place so the planted foot slides with the ground, only its vertical speed is low*/
+		for (size_t j = 0; j < cycleKeyCount; ++j)
+		{
+			float next = height[(j + 1) % cycleKeyCount];
+			float previous = height[(j + cycleKeyCount - 1) % cycleKeyCount];
+
+			speeds[j] = std::fabs(next - previous) * 0.5f;
+		}
+
+		float lowest = *std::min_element(height.begin(), height.end());
+		float highest = *std::max_element(height.begin(), height.end());
+		float fastest = *std::max_element(speeds.begin(), speeds.end());
+
+		float heightLimit = lowest + (highest - lowest) * g_contactHeightRatio;
+		float speedLimit = fastest * g_contactSpeedRatio;
+
+		std::vector<bool> contacts(cycleKeyCount);
+
+		for (size_t j = 0; j < cycleKeyCount; ++j)
+		{
+			contacts[j] = height[j] <= heightLimit && speeds[j] <= speedLimit;
+		}
+
+		size_t touchDown = findTouchDown(contacts);
+
+		if (touchDown == cycleKeyCount)
+			continue;
+
+		SyncMarker marker;
+		marker.m_phase = float(touchDown) / float(cycleKeyCount);
+		marker.m_foot = static_cast<Foot>(foot);
+
+		_clip.m_syncMarkers.push_back(marker);
+	}
+
+	std::sort(_clip.m_syncMarkers.begin(), _clip.m_syncMarkers.end(),
+			  [](SyncMarker const& _lhs, SyncMarker const& _rhs) { return _lhs.m_phase < _rhs.m_phase; });
+}
+
+/// Map a phase of a sync group to the phase of a clip, the left plant is at 0 and the right plant at 0.5
+float				syncPhase(AnimationClip const& _clip, float _groupPhase)
+{
+	const SyncMarker* leftPlant = nullptr;
+	const SyncMarker* rightPlant = nullptr;
+
+	for (SyncMarker const& marker : _clip.m_syncMarkers)
+	{
+		if (marker.m_foot == Foot::Left && leftPlant == nullptr)
+		{
+			leftPlant = &marker;
+		}
+		else if (marker.m_foot == Foot::Right && rightPlant == nullptr)
+		{
+			rightPlant = &marker;
+		}
+	}
+
+	if (leftPlant == nullptr)
+		return _groupPhase;
+
+	/*Part of the cycle of the clip from the left plant to the right plant*/
+	float leftToRight = rightPlant != nullptr ? wrapPhase(rightPlant->m_phase - leftPlant->m_phase) : 0.f;
+
+	/*Plants too close to be two steps of one cycle were misdetected, the clip is only shifted*/
+	if (leftToRight < g_minimumStepRatio || leftToRight > g_maximumStepRatio)
+		return wrapPhase(leftPlant->m_phase + _groupPhase);
+
+	/*Each half of the group cycle is stretched over the matching step of the clip*/
+	if (_groupPhase < 0.5f)
+		return wrapPhase(leftPlant->m_phase + _groupPhase * 2.f * leftToRight);
+
+	return wrapPhase(leftPlant->m_phase + leftToRight + (_groupPhase - 0.5f) * 2.f * (1.f - leftToRight));
+}
+
+/// Add a clip to the group, return its index
+size_t				SyncGroup::addClip(AnimationClip const& _clip, float _weight)
+{
+	m_members.push_back({ &_clip, _weight, syncPhase(_clip, m_phase) * _clip.m_duration });
+
+	return m_members.size() - 1;
+}
+
+/// Change the weight of a clip, the weights do not need to sum to 1
+void				SyncGroup::setWeight(size_t _member, float _weight)
+{
+	m_members[_member].m_weight = _weight;
+}
+
+/// Advance the phase by a cycle of the weighted clip durations and map it to every clip
+void				SyncGroup::advance(float _frameTime)
+{
+	float duration = cycleDuration();
+
+	if (duration > 0.f)
+	{
+		m_phase = wrapPhase(m_phase + _frameTime / duration);
+	}
+
+	for (Member& member : m_members)
+	{
+		member.m_time = syncPhase(*member.m_clip, m_phase) * member.m_clip->m_duration;
+	}
+}
+
+/// Duration of a cycle of the group, the durations of the clips interpolated by their weights
+float				SyncGroup::cycleDuration() const
+{
+	float weightSum = 0.f;
+	float duration = 0.f;
+
+	for (Member const& member : m_members)
+	{
+		weightSum += member.m_weight;
+		duration += member.m_weight * member.m_clip->m_duration;
+	}
+
+	return weightSum > 0.f ? duration / weightSum : 0.f;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#pragma region Animation
+
+#include "AnimationClip.h"
+#include "Skeleton.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstddef>
+#include <vector>
+
+#pragma endregion
+
+#pragma region LibMath
+
+#include "LibMath/Header/Vector/Vector3.h"
+
+#pragma endregion
+
+/// Markers
+// Place a foot plant marker on the key where each foot lands : low along _up and barely moving along _up, the clip
+// must be one cycle
+void						detectFootPlants(AnimationClip& _clip, Skeleton const& _skeleton, size_t _leftFoot,
+											 size_t _rightFoot, LibMath::Vector3 const& _up);
+// Map a phase of a sync group to the phase of a clip : the left plant is at 0 and the right plant at 0.5, a clip
+// without a right plant or whose right plant is not 0.3 to 0.7 of a cycle after the left one is only shifted and a
+// clip without a left plant keeps the phase
+float						syncPhase(AnimationClip const& _clip, float _groupPhase);
+
+/// Clips blended with one normalized phase, each clip sampled at the time its markers map the phase to
+class SyncGroup
+{
+	/// Clip of the group and its place in the blend
+	struct Member
+	{
+		const AnimationClip*	m_clip; // Clip synchronized, not owned
+		float					m_weight; // Weight in the blend and in the cycle duration
+		float					m_time; // Time of the clip at the phase of the group in seconds
+	};
+
+	/// Variables
+	std::vector<Member>			m_members;
+
+	float						m_phase = 0.f; // Phase of the group, from 0 to 1
+
+public:
+
+	/// Initialize
+	// Add a clip to the group, return its index
+	size_t						addClip(AnimationClip const& _clip, float _weight = 0.f);
+
+	/// Update
+	// Change the weight of a clip, the weights do not need to sum to 1
+	void						setWeight(size_t _member, float _weight);
+	// Advance the phase by a cycle of the weighted clip durations and map it to every clip
+	void						advance(float _frameTime);
+
+	/// Getter
+	size_t						clipCount() const { return m_members.size(); }
+	float						phase() const { return m_phase; }
+	float						weight(size_t _member) const { return m_members[_member].m_weight; }
+	// Time of a clip at the phase of the group in seconds
+	float						time(size_t _member) const { return m_members[_member].m_time; }
+	// Duration of a cycle of the group, the durations of the clips interpolated by their weights
+	float						cycleDuration() const;
+};
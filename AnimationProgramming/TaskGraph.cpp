@@ -0,0 +1,138 @@
+#include "TaskGraph.h"
+
+#pragma region Standard
+
+#include <cassert>
+
+#pragma endregion
+
+/// Add a task, return its index
+size_t				TaskGraph::addTask(std::function<void()> _work, TaskThread _thread)
+{
+	Task task;
+	task.m_work = std::move(_work);
+	task.m_thread = _thread;
+
+	m_tasks.push_back(std::move(task));
+
+	return m_tasks.size() - 1;
+}
+
+/// Make _after wait for _before
+void				TaskGraph::addDependency(size_t _before, size_t _after)
+{
+	assert(_before < m_tasks.size() && _after < m_tasks.size() && _before != _after);
+
+	m_tasks[_before].m_successors.push_back(_after);
+	++m_tasks[_after].m_dependencyCount;
+}
+
+/// Remove every task
+void				TaskGraph::clear()
+{
+	m_tasks.clear();
+}
+
+/// Queue a task whose dependencies are done, on the pool or for the calling thread
+void				TaskGraph::schedule(size_t _task)
+{
+	if (m_tasks[_task].m_thread == TaskThread::Caller)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_callerMutex);
+			m_callerReadyTasks.push_back(_task);
+		}
+
+		m_callerWakeUp.notify_one();
+		return;
+	}
+
+	m_pool->submit([this, _task]() { execute(_task); });
+}
+
+/// Run a task and schedule the successors it was the last dependency of
+void				TaskGraph::execute(size_t _task)
+{
+	Task const& task = m_tasks[_task];
+
+	task.m_work();
+
+	for (size_t successor : task.m_successors)
+	{
+		if (--m_remainingDependencies[successor] == 0)
+		{
+			schedule(successor);
+		}
+	}
+
+	/*The caller may be sleeping on the last pool task*/
+	if (--m_unfinishedTaskCount == 0)
+	{
+		std::lock_guard<std::mutex> lock(m_callerMutex);
+		m_callerWakeUp.notify_one();
+	}
+}
+
+/// Run every task once in the order of the dependencies, the calling thread runs the caller tasks and helps the pool
+void				TaskGraph::run(ThreadPool& _pool)
+{
+	if (m_tasks.empty())
+		return;
+
+	/*The counters and the ready list only grow when the graph changed*/
+	if (m_remainingDependencies.size() != m_tasks.size())
+	{
+		std::vector<std::atomic<size_t>>(m_tasks.size()).swap(m_remainingDependencies);
+		m_callerReadyTasks.reserve(m_tasks.size());
+	}
+
+	m_pool = &_pool;
+	m_unfinishedTaskCount = m_tasks.size();
+
+	for (size_t i = 0; i < m_tasks.size(); ++i)
+	{
+		m_remainingDependencies[i] = m_tasks[i].m_dependencyCount;
+	}
+
+	for (size_t i = 0; i < m_tasks.size(); ++i)
+	{
+		if (m_tasks[i].m_dependencyCount == 0)
+		{
+			schedule(i);
+		}
+	}
+
+	while (m_unfinishedTaskCount > 0)
+	{
+		size_t callerTask = m_tasks.size();
+
+		{
+			std::lock_guard<std::mutex> lock(m_callerMutex);
+
+			if (!m_callerReadyTasks.empty())
+			{
+				callerTask = m_callerReadyTasks.back();
+				m_callerReadyTasks.pop_back();
+			}
+		}
+
+		if (callerTask != m_tasks.size())
+		{
+			execute(callerTask);
+			continue;
+		}
+
+		if (_pool.runQueuedTask())
+			continue;
+
+		/*Every remaining task runs on a worker or waits for one, sleep until a caller task is ready*/
+		std::unique_lock<std::mutex> lock(m_callerMutex);
+
+		m_callerWakeUp.wait(lock, [this]() { return !m_callerReadyTasks.empty() || m_unfinishedTaskCount == 0; });
+	}
+
+	/*The workers may still be leaving the last tasks*/
+	_pool.wait();
+
+	m_pool = nullptr;
+}
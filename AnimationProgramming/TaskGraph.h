@@ -0,0 +1,78 @@
+#pragma once
+
+#pragma region Animation
+
+#include "ThreadPool.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#pragma endregion
+
+/// Thread allowed to run a task of a graph
+enum class TaskThread : uint8_t
+{
+	Any, // Any worker of the pool or the calling thread
+	Caller // Only the thread calling run, for the calls to the engine
+};
+
+/// Tasks and their dependencies, built once and run every frame on a thread pool
+class TaskGraph
+{
+	/// Work of a node and the nodes waiting for it
+	struct Task
+	{
+		std::function<void()>	m_work;
+		std::vector<size_t>		m_successors; // Tasks that depend on this one
+		size_t					m_dependencyCount = 0; // Tasks this one depends on
+		TaskThread				m_thread = TaskThread::Any;
+	};
+
+	/// Variables
+	std::vector<Task>					m_tasks;
+	std::vector<std::atomic<size_t>>	m_remainingDependencies; // Dependencies of every task not finished during run
+	std::vector<size_t>					m_callerReadyTasks; // Caller tasks whose dependencies are done, reserved for every task
+
+	std::mutex							m_callerMutex; // Protects the ready caller tasks
+	std::condition_variable				m_callerWakeUp; // Signaled when a caller task is ready or the graph is done
+
+	std::atomic<size_t>					m_unfinishedTaskCount; // Tasks of the current run not finished
+	ThreadPool*							m_pool = nullptr; // Pool of the current run
+
+	/// Run
+	// Queue a task whose dependencies are done, on the pool or for the calling thread
+	void					schedule(size_t _task);
+	// Run a task and schedule the successors it was the last dependency of
+	void					execute(size_t _task);
+
+public:
+
+	/// Constructor
+							TaskGraph() : m_unfinishedTaskCount(0) {}
+							TaskGraph(TaskGraph const&) = delete;
+	TaskGraph&				operator=(TaskGraph const&) = delete;
+
+	/// Build
+	// Add a task, return its index
+	size_t					addTask(std::function<void()> _work, TaskThread _thread = TaskThread::Any);
+	// Make _after wait for _before
+	void					addDependency(size_t _before, size_t _after);
+	// Remove every task
+	void					clear();
+
+	/// Run
+	// Run every task once in the order of the dependencies, the calling thread runs the caller tasks and helps the pool
+	void					run(ThreadPool& _pool);
+
+	/// Getter
+	size_t					taskCount() const { return m_tasks.size(); }
+};
@@ -0,0 +1,247 @@
+#include "ThreadPool.h"
+
+namespace
+{
+	/// Pool and queue of the current thread when it is a worker
+	thread_local const ThreadPool*	t_pool = nullptr;
+	thread_local size_t				t_queueIndex = 0;
+}
+
+/// Add a task after the newest one, doubling the ring when it is full
+void				ThreadPool::WorkerQueue::pushBack(std::function<void()>&& _task)
+{
+	if (m_count == m_tasks.size())
+	{
+		/*Unroll the ring in a buffer twice as big, the steady state never gets here*/
+		std::vector<std::function<void()>> tasks(m_tasks.empty() ? 64 : m_tasks.size() * 2);
+
+		for (size_t i = 0; i < m_count; ++i)
+		{
+			tasks[i] = std::move(m_tasks[(m_first + i) % m_tasks.size()]);
+		}
+
+		m_tasks.swap(tasks);
+		m_first = 0;
+	}
+
+	m_tasks[(m_first + m_count) % m_tasks.size()] = std::move(_task);
+	++m_count;
+}
+
+/// Remove the newest task, the queue must not be empty
+std::function<void()>	ThreadPool::WorkerQueue::popBack()
+{
+	--m_count;
+
+	return std::move(m_tasks[(m_first + m_count) % m_tasks.size()]);
+}
+
+/// Remove the oldest task, the queue must not be empty
+std::function<void()>	ThreadPool::WorkerQueue::popFront()
+{
+	std::function<void()> task = std::move(m_tasks[m_first]);
+
+	m_first = (m_first + 1) % m_tasks.size();
+	--m_count;
+
+	return task;
+}
+
+/// Start _workerCount threads, 0 starts one per core minus the calling thread which helps in wait
+ThreadPool::ThreadPool(size_t _workerCount) :
+	m_queuedTaskCount(0), m_pendingTaskCount(0), m_nextQueue(0)
+{
+	if (_workerCount == 0)
+	{
+		unsigned int coreCount = std::thread::hardware_concurrency();
+
+		_workerCount = coreCount > 1 ? coreCount - 1 : 0;
+	}
+
+	for (size_t i = 0; i <= _workerCount; ++i)
+	{
+		m_queues.emplace_back(new WorkerQueue());
+	}
+
+	for (size_t i = 0; i < _workerCount; ++i)
+	{
+		m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+	}
+}
+
+/// Finish the queued tasks and join the workers
+ThreadPool::~ThreadPool()
+{
+	wait();
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_isStopping = true;
+	}
+
+	m_wakeUp.notify_all();
+
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+/// Index of the queue of the calling thread
+size_t				ThreadPool::callerQueueIndex() const
+{
+	return t_pool == this ? t_queueIndex : m_queues.size() - 1;
+}
+
+/// Queue a task, tasks submitted from a worker go to its own queue
+void				ThreadPool::submit(std::function<void()> _task)
+{
+	/*Spread the tasks submitted from outside so every worker starts with local work*/
+	size_t queueIndex = t_pool == this ? t_queueIndex : m_nextQueue++ % m_queues.size();
+
+	++m_pendingTaskCount;
+
+	/*Count the task before it can be popped so the queued count never goes below zero*/
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		++m_queuedTaskCount;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_queues[queueIndex]->m_mutex);
+		m_queues[queueIndex]->pushBack(std::move(_task));
+	}
+
+	m_wakeUp.notify_all();
+}
+
+/// Pop a task from the queue of the thread or steal one, return false if every queue is empty
+bool				ThreadPool::runOneTask(size_t _queueIndex)
+{
+	std::function<void()> task;
+
+	for (size_t i = 0; i < m_queues.size() && !task; ++i)
+	{
+		size_t queueIndex = (_queueIndex + i) % m_queues.size();
+		WorkerQueue& queue = *m_queues[queueIndex];
+
+		std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+		if (queue.m_count == 0)
+			continue;
+
+		/*The newest task of its own queue is the most likely to be in cache, a thief takes the oldest and biggest one*/
+		task = i == 0 ? queue.popBack() : queue.popFront();
+	}
+
+	if (!task)
+		return false;
+
+	--m_queuedTaskCount;
+
+	task();
+
+	if (--m_pendingTaskCount == 0)
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_wakeUp.notify_all();
+	}
+
+	return true;
+}
+
+/// Loop of a worker thread
+void				ThreadPool::workerLoop(size_t _queueIndex)
+{
+	t_pool = this;
+	t_queueIndex = _queueIndex;
+
+	while (true)
+	{
+		if (runOneTask(_queueIndex))
+			continue;
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+		m_wakeUp.wait(lock, [this]() { return m_isStopping || m_queuedTaskCount > 0; });
+
+		if (m_isStopping && m_queuedTaskCount == 0)
+			return;
+	}
+}
+
+/// Run tasks on the calling thread until every submitted task is done, to drain the pool
+void				ThreadPool::wait()
+{
+	size_t queueIndex = callerQueueIndex();
+
+	while (m_pendingTaskCount > 0)
+	{
+		if (runOneTask(queueIndex))
+			continue;
+
+		/*Every remaining task is running on a worker, sleep until one finishes or queues new work*/
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+		m_wakeUp.wait(lock, [this]() { return m_pendingTaskCount == 0 || m_queuedTaskCount > 0; });
+	}
+}
+
+/// Run one queued task on the calling thread, return false if every queue is empty
+bool				ThreadPool::runQueuedTask()
+{
+	return runOneTask(callerQueueIndex());
+}
+
+/// Split [0, _count) in ranges of _grainSize elements, run them on the pool and help until they are done, the other
+/// tasks of the pool are not waited for
+void				ThreadPool::parallelFor(size_t _count, size_t _grainSize, 
+											std::function<void(size_t, size_t)> const& _body)
+{
+	if (_grainSize == 0)
+		_grainSize = 1;
+
+	/*The tasks only capture the range and their first element so they fit in the storage of std::function*/
+	struct Range
+	{
+		std::function<void(size_t, size_t)> const&	m_body;
+		size_t										m_count;
+		size_t										m_grainSize;
+		ThreadPool*									m_pool;
+		std::atomic<size_t>							m_remainingTaskCount; // Tasks of this call not finished
+	};
+
+	Range range = { _body, _count, _grainSize, this, { (_count + _grainSize - 1) / _grainSize } };
+
+	for (size_t begin = 0; begin < _count; begin += _grainSize)
+	{
+		submit([&range, begin]()
+		{
+			size_t end = begin + range.m_grainSize < range.m_count ? begin + range.m_grainSize : range.m_count;
+
+			range.m_body(begin, end);
+
+			/*The range lives on the stack of the caller, it may be gone once the count reaches zero*/
+			ThreadPool* pool = range.m_pool;
+
+			if (--range.m_remainingTaskCount == 0)
+			{
+				std::lock_guard<std::mutex> lock(pool->m_sleepMutex);
+				pool->m_wakeUp.notify_all();
+			}
+		});
+	}
+
+	/*Only the tasks of this call are waited for, a task of the pool can call parallelFor without waiting for itself*/
+	size_t queueIndex = callerQueueIndex();
+
+	while (range.m_remainingTaskCount > 0)
+	{
+		if (runOneTask(queueIndex))
+			continue;
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+		m_wakeUp.wait(lock, [this, &range]() { return range.m_remainingTaskCount == 0 || m_queuedTaskCount > 0; });
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#pragma region Standard
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#pragma endregion
+
+/// Worker threads with one task queue each, idle workers steal tasks from the others
+class ThreadPool
+{
+	/// Tasks of one thread, the owner pops the newest task and thieves take the oldest
+	struct WorkerQueue
+	{
+		std::mutex							m_mutex;
+		std::vector<std::function<void()>>	m_tasks; // Ring buffer, only reallocated when it is full
+		size_t								m_first = 0; // Oldest task in the ring
+		size_t								m_count = 0; // Tasks in the ring
+
+		/// Task
+		// Add a task after the newest one, doubling the ring when it is full
+		void								pushBack(std::function<void()>&& _task);
+		// Remove the newest task, the queue must not be empty
+		std::function<void()>				popBack();
+		// Remove the oldest task, the queue must not be empty
+		std::function<void()>				popFront();
+	};
+
+	/// Variables
+	std::vector<std::thread>					m_threads;
+	std::vector<std::unique_ptr<WorkerQueue>>	m_queues; // One per worker, the last one is filled by the other threads
+
+	std::mutex									m_sleepMutex; // Protects the sleeping workers and waiters
+	std::condition_variable						m_wakeUp; // Signaled when a task is queued or every task is done
+
+	std::atomic<size_t>							m_queuedTaskCount; // Tasks waiting in a queue
+	std::atomic<size_t>							m_pendingTaskCount; // Tasks submitted and not finished
+	std::atomic<size_t>							m_nextQueue; // Round robin queue for tasks submitted from outside
+
+	bool										m_isStopping = false;
+
+	/// Run
+	// Pop a task from the queue of the thread or steal one, return false if every queue is empty
+	bool					runOneTask(size_t _queueIndex);
+	// Loop of a worker thread
+	void					workerLoop(size_t _queueIndex);
+	// Index of the queue of the calling thread
+	size_t					callerQueueIndex() const;
+
+public:
+
+	/// Constructor
+	// Start _workerCount threads, 0 starts one per core minus the calling thread which helps in wait
+	explicit				ThreadPool(size_t _workerCount = 0);
+							ThreadPool(ThreadPool const&) = delete;
+	ThreadPool&				operator=(ThreadPool const&) = delete;
+
+	/// Destructor
+	// Finish the queued tasks and join the workers
+							~ThreadPool();
+
+	/// Task
+	// Queue a task, tasks submitted from a worker go to its own queue
+	void					submit(std::function<void()> _task);
+	// Run tasks on the calling thread until every submitted task is done, to drain the pool
+	void					wait();
+	// Run one queued task on the calling thread, return false if every queue is empty
+	bool					runQueuedTask();
+	// Split [0, _count) in ranges of _grainSize elements, run them on the pool and help until they are done, the other
+	// tasks of the pool are not waited for
+	void					parallelFor(size_t _count, size_t _grainSize, std::function<void(size_t, size_t)> const& _body);
+
+	/// Getter
+	size_t					workerCount() const { return m_threads.size(); }
+};
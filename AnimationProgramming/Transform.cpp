@@ -4,6 +4,192 @@
 
 #include "LibMath/Header/Matrix/Matrix4.h"
 #include "LibMath/Header/Arithmetic.h"
+#include "LibMath/Header/SIMD.h"
+
+#pragma endregion
+
+#if LIBMATH_X86
+#include <immintrin.h>
+#endif
+
+#pragma region Conversion kernels
+
+namespace
+{
+	/// Signature shared by every batched conversion kernel
+	typedef void (*ConversionKernel)(TransformArrays const&, LibMath::Matrix4*, size_t, size_t);
+
+	/// Convert the transforms from _begin to _end one at a time
+	void				transformToMatrix4Scalar(TransformArrays const& _transforms, LibMath::Matrix4* _matrices, 
+												 size_t _begin, size_t _end)
+	{
+		for (size_t i = _begin; i < _end; ++i)
+		{
+			Transform transform;
+			transform.m_position	= LibMath::Vector3(_transforms.m_positions.m_x[i], _transforms.m_positions.m_y[i], 
+													   _transforms.m_positions.m_z[i]);
+			transform.m_rotation	= LibMath::Quaternion(_transforms.m_rotations.m_a[i], _transforms.m_rotations.m_b[i], 
+														  _transforms.m_rotations.m_c[i], _transforms.m_rotations.m_d[i]);
+			transform.m_scale		= LibMath::Vector3(_transforms.m_scales.m_x[i], _transforms.m_scales.m_y[i], 
+													   _transforms.m_scales.m_z[i]);
+
+			_matrices[i] = transformToMatrix4(transform);
+		}
+	}
+
+#if LIBMATH_X86
+	/// Convert four transforms at a time then transpose the rows into the matrices
+	void				transformToMatrix4SSE(TransformArrays const& _transforms, LibMath::Matrix4* _matrices, 
+											  size_t _begin, size_t _end)
+	{
+		size_t i = _begin;
+
+		for (; i + 4 <= _end; i += 4)
+		{
+			__m128 a = _mm_loadu_ps(_transforms.m_rotations.m_a + i);
+			__m128 b = _mm_loadu_ps(_transforms.m_rotations.m_b + i);
+			__m128 c = _mm_loadu_ps(_transforms.m_rotations.m_c + i);
+			__m128 d = _mm_loadu_ps(_transforms.m_rotations.m_d + i);
+
+			__m128 scaleX = _mm_loadu_ps(_transforms.m_scales.m_x + i);
+			__m128 scaleY = _mm_loadu_ps(_transforms.m_scales.m_y + i);
+			__m128 scaleZ = _mm_loadu_ps(_transforms.m_scales.m_z + i);
+
+			__m128 aa = _mm_mul_ps(a, a);
+			__m128 bb = _mm_mul_ps(b, b);
+			__m128 cc = _mm_mul_ps(c, c);
+			__m128 dd = _mm_mul_ps(d, d);
+
+			__m128 two = _mm_set1_ps(2.f);
+			__m128 ab = _mm_mul_ps(two, _mm_mul_ps(a, b));
+			__m128 ac = _mm_mul_ps(two, _mm_mul_ps(a, c));
+			__m128 ad = _mm_mul_ps(two, _mm_mul_ps(a, d));
+			__m128 bc = _mm_mul_ps(two, _mm_mul_ps(b, c));
+			__m128 bd = _mm_mul_ps(two, _mm_mul_ps(b, d));
+			__m128 cd = _mm_mul_ps(two, _mm_mul_ps(c, d));
+
+			// Each register holds one element of the four matrices
+			__m128 rows[4][4] =
+			{
+				{ _mm_mul_ps(_mm_sub_ps(_mm_add_ps(aa, bb), _mm_add_ps(cc, dd)), scaleX),
+				  _mm_mul_ps(_mm_add_ps(bc, ad), scaleX), _mm_mul_ps(_mm_sub_ps(bd, ac), scaleX), _mm_setzero_ps() },
+				{ _mm_mul_ps(_mm_sub_ps(bc, ad), scaleY), 
+				  _mm_mul_ps(_mm_sub_ps(_mm_add_ps(aa, cc), _mm_add_ps(bb, dd)), scaleY),
+				  _mm_mul_ps(_mm_add_ps(cd, ab), scaleY), _mm_setzero_ps() },
+				{ _mm_mul_ps(_mm_add_ps(bd, ac), scaleZ), _mm_mul_ps(_mm_sub_ps(cd, ab), scaleZ),
+				  _mm_mul_ps(_mm_sub_ps(_mm_add_ps(aa, dd), _mm_add_ps(bb, cc)), scaleZ), _mm_setzero_ps() },
+				{ _mm_loadu_ps(_transforms.m_positions.m_x + i), _mm_loadu_ps(_transforms.m_positions.m_y + i),
+				  _mm_loadu_ps(_transforms.m_positions.m_z + i), _mm_set1_ps(1.f) }
+			};
+
+			for (int row = 0; row < 4; ++row)
+			{
+				_MM_TRANSPOSE4_PS(rows[row][0], rows[row][1], rows[row][2], rows[row][3]);
+
+				for (int matrix = 0; matrix < 4; ++matrix)
+				{
+					_mm_storeu_ps(_matrices[i + matrix].m_matrix[row], rows[row][matrix]);
+				}
+			}
+		}
+
+		transformToMatrix4Scalar(_transforms, _matrices, i, _end);
+	}
+
+	/// Transpose one row of eight matrices, each 128 bits lane holds four of them
+	LIBMATH_TARGET_AVX
+	void				storeRowsAVX(__m256 _x, __m256 _y, __m256 _z, __m256 _w, LibMath::Matrix4* _matrices, int _row)
+	{
+		__m256 xyLow = _mm256_unpacklo_ps(_x, _y);
+		__m256 xyHigh = _mm256_unpackhi_ps(_x, _y);
+		__m256 zwLow = _mm256_unpacklo_ps(_z, _w);
+		__m256 zwHigh = _mm256_unpackhi_ps(_z, _w);
+
+		__m256 rows[4] =
+		{
+			_mm256_shuffle_ps(xyLow, zwLow, 0x44),
+			_mm256_shuffle_ps(xyLow, zwLow, 0xEE),
+			_mm256_shuffle_ps(xyHigh, zwHigh, 0x44),
+			_mm256_shuffle_ps(xyHigh, zwHigh, 0xEE)
+		};
+
+		for (int matrix = 0; matrix < 4; ++matrix)
+		{
+			_mm_storeu_ps(_matrices[matrix].m_matrix[_row], _mm256_castps256_ps128(rows[matrix]));
+			_mm_storeu_ps(_matrices[matrix + 4].m_matrix[_row], _mm256_extractf128_ps(rows[matrix], 1));
+		}
+	}
+
+	/// Convert eight transforms at a time with 256 bits registers
+	LIBMATH_TARGET_AVX
+	void				transformToMatrix4AVX(TransformArrays const& _transforms, LibMath::Matrix4* _matrices, 
+											  size_t _begin, size_t _end)
+	{
+		size_t i = _begin;
+
+		for (; i + 8 <= _end; i += 8)
+		{
+			__m256 a = _mm256_loadu_ps(_transforms.m_rotations.m_a + i);
+			__m256 b = _mm256_loadu_ps(_transforms.m_rotations.m_b + i);
+			__m256 c = _mm256_loadu_ps(_transforms.m_rotations.m_c + i);
+			__m256 d = _mm256_loadu_ps(_transforms.m_rotations.m_d + i);
+
+			__m256 scaleX = _mm256_loadu_ps(_transforms.m_scales.m_x + i);
+			__m256 scaleY = _mm256_loadu_ps(_transforms.m_scales.m_y + i);
+			__m256 scaleZ = _mm256_loadu_ps(_transforms.m_scales.m_z + i);
+
+			__m256 aa = _mm256_mul_ps(a, a);
+			__m256 bb = _mm256_mul_ps(b, b);
+			__m256 cc = _mm256_mul_ps(c, c);
+			__m256 dd = _mm256_mul_ps(d, d);
+
+			__m256 two = _mm256_set1_ps(2.f);
+			__m256 ab = _mm256_mul_ps(two, _mm256_mul_ps(a, b));
+			__m256 ac = _mm256_mul_ps(two, _mm256_mul_ps(a, c));
+			__m256 ad = _mm256_mul_ps(two, _mm256_mul_ps(a, d));
+			__m256 bc = _mm256_mul_ps(two, _mm256_mul_ps(b, c));
+			__m256 bd = _mm256_mul_ps(two, _mm256_mul_ps(b, d));
+			__m256 cd = _mm256_mul_ps(two, _mm256_mul_ps(c, d));
+
+			__m256 zero = _mm256_setzero_ps();
+
+			storeRowsAVX(_mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(aa, bb), _mm256_add_ps(cc, dd)), scaleX),
+						 _mm256_mul_ps(_mm256_add_ps(bc, ad), scaleX), _mm256_mul_ps(_mm256_sub_ps(bd, ac), scaleX), 
+						 zero, _matrices + i, 0);
+			storeRowsAVX(_mm256_mul_ps(_mm256_sub_ps(bc, ad), scaleY),
+						 _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(aa, cc), _mm256_add_ps(bb, dd)), scaleY),
+						 _mm256_mul_ps(_mm256_add_ps(cd, ab), scaleY), zero, _matrices + i, 1);
+			storeRowsAVX(_mm256_mul_ps(_mm256_add_ps(bd, ac), scaleZ), _mm256_mul_ps(_mm256_sub_ps(cd, ab), scaleZ),
+						 _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(aa, dd), _mm256_add_ps(bb, cc)), scaleZ), 
+						 zero, _matrices + i, 2);
+			storeRowsAVX(_mm256_loadu_ps(_transforms.m_positions.m_x + i), _mm256_loadu_ps(_transforms.m_positions.m_y + i),
+						 _mm256_loadu_ps(_transforms.m_positions.m_z + i), _mm256_set1_ps(1.f), _matrices + i, 3);
+		}
+
+		transformToMatrix4Scalar(_transforms, _matrices, i, _end);
+	}
+#endif
+
+	/// Return the conversion kernel matching an instruction set
+	ConversionKernel	conversionKernel(LibMath::InstructionSet _instructionSet)
+	{
+#if LIBMATH_X86
+		switch (_instructionSet)
+		{
+		// The conversion has no multiply-add to fuse, AVX2 uses the AVX kernel
+		case LibMath::InstructionSet::AVX2:
+		case LibMath::InstructionSet::AVX:
+			return transformToMatrix4AVX;
+		case LibMath::InstructionSet::SSE:
+			return transformToMatrix4SSE;
+		default:
+			return transformToMatrix4Scalar;
+		}
+#else
+		return transformToMatrix4Scalar;
+#endif
+	}
+}
 
 #pragma endregion
 
@@ -46,6 +232,35 @@ Transform operator*(Transform const& _lhs, Transform const& _rhs)
 	return result;
 }
 
+/// Equality operator, true when every component is exactly the same
+bool operator==(Transform const& _lhs, Transform const& _rhs)
+{
+	return _lhs.m_position.m_x == _rhs.m_position.m_x && _lhs.m_position.m_y == _rhs.m_position.m_y &&
+		   _lhs.m_position.m_z == _rhs.m_position.m_z &&
+		   _lhs.m_rotation.m_a == _rhs.m_rotation.m_a && _lhs.m_rotation.m_b == _rhs.m_rotation.m_b &&
+		   _lhs.m_rotation.m_c == _rhs.m_rotation.m_c && _lhs.m_rotation.m_d == _rhs.m_rotation.m_d &&
+		   _lhs.m_scale.m_x == _rhs.m_scale.m_x && _lhs.m_scale.m_y == _rhs.m_scale.m_y && 
+		   _lhs.m_scale.m_z == _rhs.m_scale.m_z;
+}
+
+/// Inequality operator
+bool operator!=(Transform const& _lhs, Transform const& _rhs)
+{
+	return !(_lhs == _rhs);
+}
+
+/// Return the transform that undoes this one (exact for uniform scale)
+Transform inverse(Transform const& _transform)
+{
+	Transform result;
+
+	result.m_rotation	= LibMath::conjugate(_transform.m_rotation);
+	result.m_scale		= LibMath::Vector3(1.f, 1.f, 1.f) / _transform.m_scale;
+	result.m_position	= -((_transform.m_position * result.m_rotation) * result.m_scale);
+
+	return result;
+}
+
 /// Convert a vector 3 position to matrix4
 LibMath::Matrix4 positionToMatrix4(LibMath::Vector3 const& _position)
 {
@@ -66,27 +281,49 @@ LibMath::Matrix4 scaleToMatrix4(LibMath::Vector3 const& _scale)
 	return resultScale;
 }
 
-/// Convert a transform to a matrix4
+/// Convert a transform to a matrix4 written directly from the scale, rotation and position
 LibMath::Matrix4 transformToMatrix4(Transform const& _transform)
 {
-	LibMath::Matrix4 scaleMatrix = scaleToMatrix4(_transform.m_scale);
+	LibMath::Quaternion const& rotation = _transform.m_rotation;
+	LibMath::Vector3 const& scale = _transform.m_scale;
 
-	LibMath::Matrix4 rotationMatrix = LibMath::toMatrix4(_transform.m_rotation);
+	const float aa = rotation.m_a * rotation.m_a;
+	const float bb = rotation.m_b * rotation.m_b;
+	const float cc = rotation.m_c * rotation.m_c;
+	const float dd = rotation.m_d * rotation.m_d;
 
-	LibMath::Matrix4 translationMatrix = positionToMatrix4(_transform.m_position);
+	const float ab = 2.f * rotation.m_a * rotation.m_b;
+	const float ac = 2.f * rotation.m_a * rotation.m_c;
+	const float ad = 2.f * rotation.m_a * rotation.m_d;
+	const float bc = 2.f * rotation.m_b * rotation.m_c;
+	const float bd = 2.f * rotation.m_b * rotation.m_d;
+	const float cd = 2.f * rotation.m_c * rotation.m_d;
 
-	LibMath::Matrix4 transformMatrix = (scaleMatrix * rotationMatrix) * translationMatrix;
+	/*Scale * Rotation * Translation: every rotation row is scaled and the position is the last row*/
+	float matrix[4][4] =
+	{
+		{ (aa + bb - cc - dd) * scale.m_x, (bc + ad) * scale.m_x, (bd - ac) * scale.m_x, 0.f },
+		{ (bc - ad) * scale.m_y, (aa - bb + cc - dd) * scale.m_y, (cd + ab) * scale.m_y, 0.f },
+		{ (bd + ac) * scale.m_z, (cd - ab) * scale.m_z, (aa - bb - cc + dd) * scale.m_z, 0.f },
+		{ _transform.m_position.m_x, _transform.m_position.m_y, _transform.m_position.m_z, 1.f }
+	};
 
-	return transformMatrix;
+	return LibMath::Matrix4(matrix);
+}
+
+/// Convert _count transforms stored as arrays to matrices with the active instruction set
+void transformToMatrix4(TransformArrays const& _transforms, LibMath::Matrix4* _matrices, size_t _count)
+{
+	conversionKernel(LibMath::activeInstructionSet())(_transforms, _matrices, 0, _count);
 }
 
 /// Interpolate between two transforms
-Transform interpolate(Transform const& _a, Transform const& _b, float _t)
+Transform interpolate(Transform const& _a, Transform const& _b, float _t, LibMath::RotationInterpolation _interpolation)
 {
 	Transform result;
 
 	result.m_position	= LibMath::Vector3::lerpPosition(_a.m_position, _b.m_position, _t);
-	result.m_rotation	= LibMath::slerp(_a.m_rotation, _b.m_rotation, _t);
+	result.m_rotation	= LibMath::interpolateRotation(_a.m_rotation, _b.m_rotation, _t, _interpolation);
 	result.m_scale		= LibMath::Vector3::lerpScale(_a.m_scale, _b.m_scale, _t);
 
 	return result;
@@ -7,6 +7,14 @@
 
 #pragma endregion
 
+/// Transforms stored as one array per component, so several bones fill a vector register
+struct TransformArrays
+{
+	LibMath::Vector3Arrays		m_positions;
+	LibMath::QuaternionArrays	m_rotations;
+	LibMath::Vector3Arrays		m_scales;
+};
+
 /// Basic struct of a transform without scale (considered as 1)
 struct Transform
 {
@@ -27,6 +35,15 @@ struct Transform
 Transform				operator-(Transform const& _other);
 // Multiplication operator considered as combine two transforms
 Transform				operator*(Transform const& _lhs, Transform const& _rhs);
+// Equality operator, true when every component is exactly the same
+bool					operator==(Transform const& _lhs, Transform const& _rhs);
+// Inequality operator
+bool					operator!=(Transform const& _lhs, Transform const& _rhs);
+
+
+/// Inverse
+// Return the transform that undoes this one (exact for uniform scale)
+Transform				inverse(Transform const& _transform);
 
 
 /// Conversion
@@ -34,9 +51,12 @@ Transform				operator*(Transform const& _lhs, Transform const& _rhs);
 LibMath::Matrix4		positionToMatrix4(LibMath::Vector3 const& _position);
 // Convert a vector 3 scale to matrix4
 LibMath::Matrix4		scaleToMatrix4(LibMath::Vector3 const& _scale);
-// Convert a transform to a matrix4
+// Convert a transform to a matrix4 written directly from the scale, rotation and position
 LibMath::Matrix4		transformToMatrix4(Transform const& _transform);
+// Convert _count transforms stored as arrays to matrices with the active instruction set
+void					transformToMatrix4(TransformArrays const& _transforms, LibMath::Matrix4* _matrices, size_t _count);
 
 /// Interpolation
 // Interpolate between two transforms
-Transform				interpolate(Transform const& _a, Transform const& _b, float _t);
\ No newline at end of file
+Transform				interpolate(Transform const& _a, Transform const& _b, float _t, 
+									LibMath::RotationInterpolation _interpolation = LibMath::RotationInterpolation::Slerp);
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "WorldPoseCache.h"
+
+#pragma region Standard
+
+#include <algorithm>
+
+#pragma endregion
+
+/// Return the baked clip of a clip, null if it is not baked
+const WorldPoseCache::BakedClip*	WorldPoseCache::findClip(AnimationClip const& _clip) const
+{
+	for (BakedClip const& bakedClip : m_bakedClips)
+	{
+		if (bakedClip.m_clip == &_clip)
+			return &bakedClip;
+	}
+
+	return nullptr;
+}
+
+/// Bake the clips in order of priority, skipping those too large for what is left of _budget bytes, return the count
+size_t				WorldPoseCache::bake(Skeleton const& _skeleton, std::vector<const AnimationClip*> const& _clips,
+										 size_t _budget)
+{
+	clear();
+
+	m_boneCount = _skeleton.m_boneCount;
+
+	/*Place the clips that fit first so the buffer is allocated once*/
+	size_t transformCount = 0;
+
+	for (const AnimationClip* clip : _clips)
+	{
+		size_t clipTransformCount = clip->m_keyCount * m_boneCount;
+
+		if ((transformCount + clipTransformCount) * sizeof(Transform) > _budget)
+			continue;
+
+		m_bakedClips.push_back({ clip, transformCount });
+		transformCount += clipTransformCount;
+	}
+
+	m_worldPoses.resize(transformCount);
+
+	std::vector<Transform> localPose(m_boneCount);
+
+	for (BakedClip const& bakedClip : m_bakedClips)
+	{
+		/*The same forward kinematics as the sampled path, once per key*/
+		for (size_t j = 0; j < bakedClip.m_clip->m_keyCount; ++j)
+		{
+			bakedClip.m_clip->sampleKey(j, localPose.data());
+
+			_skeleton.computeWorldPose(localPose.data(), &m_worldPoses[bakedClip.m_offset + j * m_boneCount]);
+		}
+	}
+
+	return m_bakedClips.size();
+}
+
+/// Release the buffer
+void				WorldPoseCache::clear()
+{
+	m_worldPoses.clear();
+	m_worldPoses.shrink_to_fit();
+	m_bakedClips.clear();
+}
+
+/// Get the world pose of a key of a baked clip, null if the clip is not baked
+const Transform*	WorldPoseCache::worldPose(AnimationClip const& _clip, size_t _key) const
+{
+	const BakedClip* bakedClip = findClip(_clip);
+
+	return bakedClip != nullptr ? &m_worldPoses[bakedClip->m_offset + _key * m_boneCount] : nullptr;
+}
+
+/// Interpolate the baked world pose of a clip at a time in seconds, return false if the clip is not baked
+bool				WorldPoseCache::sampleTime(AnimationClip const& _clip, float _time, Transform* _worldPose) const
+{
+	const BakedClip* bakedClip = findClip(_clip);
+
+	if (bakedClip == nullptr)
+		return false;
+
+	KeyPosition position = findKeyPosition(_time, _clip.m_duration, _clip.m_keyCount);
+
+	const Transform* worldPose = &m_worldPoses[bakedClip->m_offset + position.m_key * m_boneCount];
+	const Transform* nextWorldPose = &m_worldPoses[bakedClip->m_offset + position.m_nextKey * m_boneCount];
+
+	if (position.m_key == position.m_nextKey)
+	{
+		std::copy(worldPose, worldPose + m_boneCount, _worldPose);
+		return true;
+	}
+
+	/*World transforms are interpolated directly, there is no hierarchy left to walk*/
+	for (size_t i = 0; i < m_boneCount; ++i)
+	{
+		_worldPose[i] = interpolate(worldPose[i], nextWorldPose[i], position.m_t, _clip.m_rotationInterpolation);
+	}
+
+	return true;
+}
+
+/// Memory a clip needs once baked in bytes
+size_t				WorldPoseCache::bakedSize(AnimationClip const& _clip)
+{
+	return _clip.m_keyCount * _clip.m_boneCount * sizeof(Transform);
+}
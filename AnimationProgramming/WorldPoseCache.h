@@ -0,0 +1,60 @@
+#pragma once
+
+#pragma region Animation
+
+#include "Transform.h"
+#include "AnimationClip.h"
+#include "Skeleton.h"
+
+#pragma endregion
+
+#pragma region Standard
+
+#include <cstddef>
+#include <vector>
+
+#pragma endregion
+
+/// World pose of every key of the clips that fit a memory budget, baked once in one contiguous buffer.
+/// Sampling a baked clip interpolates two world poses instead of sampling the local keys and walking the hierarchy
+class WorldPoseCache
+{
+	/// Place of a baked clip in the buffer
+	struct BakedClip
+	{
+		const AnimationClip*	m_clip; // Clip baked, not owned
+		size_t					m_offset; // First transform of the clip in the buffer
+	};
+
+	/// Variables
+	std::vector<Transform>		m_worldPoses; // World transform of every bone for every key of every baked clip, key-major
+	std::vector<BakedClip>		m_bakedClips;
+
+	size_t						m_boneCount = 0; // Number of bones of the skeleton baked
+
+	// Return the baked clip of a clip, null if it is not baked
+	const BakedClip*			findClip(AnimationClip const& _clip) const;
+
+public:
+
+	/// Bake
+	// Bake the clips in order of priority, skipping those too large for what is left of _budget bytes, return the count
+	size_t						bake(Skeleton const& _skeleton, std::vector<const AnimationClip*> const& _clips,
+									 size_t _budget);
+	// Release the buffer
+	void						clear();
+
+	/// Sample
+	// Get the world pose of a key of a baked clip, null if the clip is not baked
+	const Transform*			worldPose(AnimationClip const& _clip, size_t _key) const;
+	// Interpolate the baked world pose of a clip at a time in seconds, return false if the clip is not baked
+	bool						sampleTime(AnimationClip const& _clip, float _time, Transform* _worldPose) const;
+
+	/// Getter
+	bool						isBaked(AnimationClip const& _clip) const { return findClip(_clip) != nullptr; }
+	size_t						bakedClipCount() const { return m_bakedClips.size(); }
+	// Memory used by the baked poses in bytes
+	size_t						footprint() const { return m_worldPoses.size() * sizeof(Transform); }
+	// Memory a clip needs once baked in bytes
+	static size_t				bakedSize(AnimationClip const& _clip);
+};
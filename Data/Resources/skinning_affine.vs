@@ -0,0 +1,60 @@
+
+/////////////////////
+// INPUT VARIABLES //
+/////////////////////
+in lowp vec3 inputPosition;
+in lowp vec3 normal;
+in lowp vec4 boneIndices;
+in lowp vec4 boneWeights;
+
+//////////////////////
+// OUTPUT VARIABLES //
+//////////////////////
+smooth out vec2 texCoord;
+smooth out vec3 outNormal;
+
+uniform SceneMatrices
+{
+	uniform mat4 projectionMatrix;
+} sm;
+
+uniform mat4 modelViewMatrix;
+
+// Three rows per bone : the columns of the skinning matrix, translation in w
+uniform SkinningMatrices
+{
+	uniform vec4 rows[192];
+} skin;
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Vertex Shader
+////////////////////////////////////////////////////////////////////////////////
+void main(void)
+{
+	vec4 pos = vec4(inputPosition, 1.0f);
+	
+	float scalar = 1.0 / (boneWeights.x + boneWeights.y + boneWeights.z + boneWeights.w);
+
+	int bone0 = 3 * int(boneIndices.x);
+	int bone1 = 3 * int(boneIndices.y);
+	int bone2 = 3 * int(boneIndices.z);
+	int bone3 = 3 * int(boneIndices.w);
+
+	vec4 weights = scalar * boneWeights;
+
+	vec4 row0 = weights.w * skin.rows[bone3] + weights.z * skin.rows[bone2] +
+				weights.y * skin.rows[bone1] + weights.x * skin.rows[bone0];
+	vec4 row1 = weights.w * skin.rows[bone3 + 1] + weights.z * skin.rows[bone2 + 1] +
+				weights.y * skin.rows[bone1 + 1] + weights.x * skin.rows[bone0 + 1];
+	vec4 row2 = weights.w * skin.rows[bone3 + 2] + weights.z * skin.rows[bone2 + 2] +
+				weights.y * skin.rows[bone1 + 2] + weights.x * skin.rows[bone0 + 2];
+
+	pos = vec4(dot(row0, pos), dot(row1, pos), dot(row2, pos), 1.0f);
+
+	gl_Position = sm.projectionMatrix * (modelViewMatrix * vec4(pos.xyz, 1.0f));
+	outNormal = mat3(modelViewMatrix) * normal;
+	
+	outNormal = normalize(outNormal);
+}
@@ -0,0 +1,66 @@
+
+/////////////////////
+// INPUT VARIABLES //
+/////////////////////
+in lowp vec3 inputPosition;
+in lowp vec3 normal;
+in lowp vec4 boneIndices;
+in lowp vec4 boneWeights;
+
+//////////////////////
+// OUTPUT VARIABLES //
+//////////////////////
+smooth out vec2 texCoord;
+smooth out vec3 outNormal;
+
+uniform SceneMatrices
+{
+	uniform mat4 projectionMatrix;
+} sm;
+
+uniform mat4 modelViewMatrix;
+
+// Two quaternions per bone : the rotation, then half the translation times the rotation
+uniform SkinningMatrices
+{
+	uniform vec4 dq[128];
+} skin;
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Vertex Shader
+////////////////////////////////////////////////////////////////////////////////
+void main(void)
+{
+	vec3 pos = inputPosition;
+
+	int bone0 = 2 * int(boneIndices.x);
+	int bone1 = 2 * int(boneIndices.y);
+	int bone2 = 2 * int(boneIndices.z);
+	int bone3 = 2 * int(boneIndices.w);
+
+	// Quaternions are stored w, x, y, z : blend on the hemisphere of the first bone
+	vec4 first = skin.dq[bone0];
+	vec4 weights = boneWeights * vec4(1.0f, sign(dot(first, skin.dq[bone1]) + 0.0001f), 
+									  sign(dot(first, skin.dq[bone2]) + 0.0001f), sign(dot(first, skin.dq[bone3]) + 0.0001f));
+
+	vec4 real = weights.x * skin.dq[bone0] + weights.y * skin.dq[bone1] + 
+				weights.z * skin.dq[bone2] + weights.w * skin.dq[bone3];
+	vec4 dual = weights.x * skin.dq[bone0 + 1] + weights.y * skin.dq[bone1 + 1] + 
+				weights.z * skin.dq[bone2 + 1] + weights.w * skin.dq[bone3 + 1];
+
+	// Normalizing by the real part also removes the weight sum
+	float invLength = 1.0f / length(real);
+	real *= invLength;
+	dual *= invLength;
+
+	vec3 translation = 2.0f * (real.x * dual.yzw - dual.x * real.yzw + cross(real.yzw, dual.yzw));
+
+	pos = pos + 2.0f * cross(real.yzw, cross(real.yzw, pos) + real.x * pos) + translation;
+
+	gl_Position = sm.projectionMatrix * (modelViewMatrix * vec4(pos, 1.0f));
+	outNormal = mat3(modelViewMatrix) * normal;
+	
+	outNormal = normalize(outNormal);
+}